@@ -0,0 +1,199 @@
+/*
+ *  COBS_Benchmark.c
+ *
+ *  Brief: host side benchmark of the UART COBS framing throughput against the raw "unframed" copy of the same packets
+ *  it's NOT a part of the MCAL , the encoder and the decoder below are the same steps as UART_SendPacket() and the RX-ISR
+ *  incremental decoder but they write to arrays instead of the UART_TX_Buffer and the UART_RX_Buffer
+ *
+ *  build : gcc -O2 -I../UART -o COBS_Benchmark COBS_Benchmark.c
+ *  run   : ./COBS_Benchmark [number of packets "default 2000000"]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "STD_types.h"
+#include "UART_Interface.h"
+
+#ifndef FALSE //STD_types.h guards it's FALSE by TRUE
+#define FALSE    ((u8)(0))
+#endif
+
+#define BENCHMARK_PACKET_LENGTH   64   //length of each test packet "1 to 255"
+#define BENCHMARK_ZERO_EVERY      16   //one ZERO byte every BENCHMARK_ZERO_EVERY bytes on average "0 for packets without ZEROs"
+//worst case encoded length : one code byte per COBS_MAX_BLOCK bytes + the first code byte + the delimiter
+#define BENCHMARK_ENCODED_SIZE    (BENCHMARK_PACKET_LENGTH+2+(BENCHMARK_PACKET_LENGTH/COBS_MAX_BLOCK))
+
+static volatile u32 Benchmark_Sink; //keeps the results alive so the loops can't be optimized away
+
+
+/**
+ * RETURN      : the number of the encoded bytes "including the delimiter"
+ * PARAMETERS  : Packet is the packet to be encoded , Length is it's length and Encoded is the output array
+ * DESCRIPTION : the same block encoding steps as UART_SendPacket()
+ */
+static u16 COBS_Encode(const u8 *Packet, u8 Length, u8 *Encoded)
+{
+	u16 EncodedLength=0;
+	u8 BlockStart=0;
+	u8 BlockLength;
+	u8 Counter;
+	u8 Done=FALSE;
+	while(Done==FALSE)
+	{
+		BlockLength=0;
+		while((u16)BlockStart+BlockLength < Length && BlockLength < COBS_MAX_BLOCK && Packet[BlockStart+BlockLength] != 0)
+		{
+			BlockLength++;
+		}
+		Encoded[EncodedLength++]=BlockLength+1; //the code byte
+		for(Counter=0; Counter<BlockLength; Counter++)
+		{
+			Encoded[EncodedLength++]=Packet[BlockStart+Counter];
+		}
+		BlockStart+=BlockLength;
+		if(BlockStart >= Length)
+		{
+			Done=TRUE;
+		}
+		else if(BlockLength < COBS_MAX_BLOCK) //the block has been ended by a ZERO byte that is implied by the code byte
+		{
+			BlockStart++;
+			if(BlockStart == Length) //the packet ends with a ZERO byte , it's implied by an empty last block
+			{
+				Encoded[EncodedLength++]=1;
+				Done=TRUE;
+			}
+		}
+	}
+	Encoded[EncodedLength++]=COBS_DELIMITER;
+	return EncodedLength;
+}
+
+
+/**
+ * RETURN      : the number of the decoded bytes or 0xFFFF if the packet is corrupted
+ * PARAMETERS  : Encoded is the received frames "including the delimiter" , Length is their number and Decoded is the output array
+ * DESCRIPTION : the same incremental steps as the RX-ISR COBS decoder "constant work per received frame"
+ */
+static u16 COBS_Decode(const u8 *Encoded, u16 Length, u8 *Decoded)
+{
+	u16 DecodedLength=0;
+	u16 Index;
+	u8 CodeRemaining=0;
+	u8 ZeroPending=FALSE;
+	u8 Data;
+	u8 PushFrame;
+	for(Index=0; Index<Length; Index++)
+	{
+		Data=Encoded[Index];
+		PushFrame=TRUE;
+		if(Data == COBS_DELIMITER) //end of the packet
+		{
+			return (CodeRemaining != 0) ? 0xFFFF : DecodedLength;
+		}
+		else if(CodeRemaining == 0) //code byte , the previous block implied ZERO "if any" is stored instead of it
+		{
+			CodeRemaining=Data-1;
+			PushFrame=ZeroPending;
+			ZeroPending=(Data != (COBS_MAX_BLOCK+1));
+			Data=0;
+		}
+		else
+		{
+			CodeRemaining--;
+		}
+		if(PushFrame)
+		{
+			Decoded[DecodedLength++]=Data;
+		}
+	}
+	return 0xFFFF; //no delimiter
+}
+
+
+static double Benchmark_Seconds(clock_t Start)
+{
+	return (double)(clock()-Start)/CLOCKS_PER_SEC;
+}
+
+
+static void Benchmark_Report(const char *Name, unsigned long Bytes, double Seconds)
+{
+	printf("%-14s %10.3f s %10.2f MB/s\n", Name, Seconds, (Seconds > 0) ? (Bytes/Seconds)/1e6 : 0.0);
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned long Packets=(argc > 1) ? strtoul(argv[1], NULL, 10) : 2000000UL;
+	unsigned long Done;
+	u8 Packet[BENCHMARK_PACKET_LENGTH];
+	volatile u8 Copy[BENCHMARK_PACKET_LENGTH]; //volatile so the copy isn't reduced to the two bytes that are summed
+	u8 Encoded[BENCHMARK_ENCODED_SIZE];
+	u8 Decoded[BENCHMARK_PACKET_LENGTH];
+	u16 EncodedLength;
+	u16 Counter;
+	u32 Sum;
+	clock_t Start;
+
+	srand(1);
+	for(Counter=0; Counter<BENCHMARK_PACKET_LENGTH; Counter++)
+	{
+		Packet[Counter]=(BENCHMARK_ZERO_EVERY != 0 && (rand()%BENCHMARK_ZERO_EVERY) == 0) ? 0 : (u8)(1+(rand()%255));
+	}
+
+	//make sure that the encoded packet is decoded back to the same bytes before timing anything
+	EncodedLength=COBS_Encode(Packet, BENCHMARK_PACKET_LENGTH, Encoded);
+	if(COBS_Decode(Encoded, EncodedLength, Decoded) != BENCHMARK_PACKET_LENGTH)
+	{
+		printf("COBS round trip failed\n");
+		return 1;
+	}
+	for(Counter=0; Counter<BENCHMARK_PACKET_LENGTH; Counter++)
+	{
+		if(Decoded[Counter] != Packet[Counter])
+		{
+			printf("COBS round trip failed at byte %u\n", Counter);
+			return 1;
+		}
+	}
+
+	printf("%lu packets of %d bytes , %u bytes on the wire with COBS framing\n", Packets, BENCHMARK_PACKET_LENGTH, EncodedLength);
+
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Packets; Done++)
+	{
+		Packet[0]=(u8)Done; //the packet changes every iteration so the work can't be hoisted out of the loop
+		for(Counter=0; Counter<BENCHMARK_PACKET_LENGTH; Counter++)
+		{
+			Copy[Counter]=Packet[Counter];
+		}
+		Sum+=Copy[BENCHMARK_PACKET_LENGTH-1]+Copy[0];
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("raw copy", Done*BENCHMARK_PACKET_LENGTH, Benchmark_Seconds(Start));
+
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Packets; Done++)
+	{
+		Packet[0]=(u8)Done;
+		Sum+=COBS_Encode(Packet, BENCHMARK_PACKET_LENGTH, Encoded);
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("COBS encode", Done*BENCHMARK_PACKET_LENGTH, Benchmark_Seconds(Start));
+
+	EncodedLength=COBS_Encode(Packet, BENCHMARK_PACKET_LENGTH, Encoded);
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Packets; Done++)
+	{
+		Encoded[1]=(u8)(Done|1); //keep the first data byte non ZERO so the packet stays valid
+		Sum+=COBS_Decode(Encoded, EncodedLength, Decoded)+Decoded[1];
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("COBS decode", Done*BENCHMARK_PACKET_LENGTH, Benchmark_Seconds(Start));
+
+	return 0;
+}
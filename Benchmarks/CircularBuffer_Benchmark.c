@@ -0,0 +1,117 @@
+/*
+ *  CircularBuffer_Benchmark.c
+ *
+ *  Brief: host side benchmark of the push/pop throughput of the CircularBuffer "CBuffer_*" and the SPSC "SPSC_*" buffers
+ *  it's NOT a part of the MCAL , it's built with the host gcc against the UART copy of the CircularBuffer lib
+ *
+ *  build : gcc -O2 -I../UART -o CircularBuffer_Benchmark CircularBuffer_Benchmark.c ../UART/CircularBufferProg.c
+ *  run   : ./CircularBuffer_Benchmark [number of elements "default 50000000"]
+ *
+ *  NOTE : the host has no ISRs so both sides of the buffers are executed by the same loop , the numbers compare the
+ *  cost of the buffer operations only "the UART_Config.h settings select the 8bit sizes and the BuffData_t type"
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "STD_types.h"
+#include "CircularBufferInterface.h"
+
+#define BENCHMARK_BUFFER_SIZE   64  //number of locations of each tested buffer "power of two 2 to 128 for the SPSC buffer"
+#define BENCHMARK_BURST         48  //number of elements pushed before they are popped "as an ISR fills the buffer before the main loop reads it"
+
+static volatile BuffData_t CBuffer_Storage[BENCHMARK_BUFFER_SIZE];
+static volatile BuffData_t SPSC_Storage[BENCHMARK_BUFFER_SIZE];
+static volatile u32 Benchmark_Sink; //keeps the popped data alive so the loops can't be optimized away
+
+
+static double Benchmark_Seconds(clock_t Start)
+{
+	return (double)(clock()-Start)/CLOCKS_PER_SEC;
+}
+
+
+static void Benchmark_Report(const char *Name, unsigned long Elements, double Seconds)
+{
+	printf("%-24s %10.3f s %10.2f M elements/s\n", Name, Seconds, (Seconds > 0) ? (Elements/Seconds)/1e6 : 0.0);
+}
+
+
+int main(int argc, char **argv)
+{
+	unsigned long Elements=(argc > 1) ? strtoul(argv[1], NULL, 10) : 50000000UL;
+	unsigned long Done;
+	CircularBuffer CBuffer;
+	SPSC_Buffer SPSC;
+	BuffData_t Block[BENCHMARK_BURST];
+	BuffData_t Data;
+	u32 Sum;
+	u8 Counter;
+	clock_t Start;
+
+	CBuffer_BufferInit(&CBuffer, CBuffer_Storage, BENCHMARK_BUFFER_SIZE);
+	SPSC_BufferInit(&SPSC, SPSC_Storage, BENCHMARK_BUFFER_SIZE);
+	for(Counter=0; Counter<BENCHMARK_BURST; Counter++)
+	{
+		Block[Counter]=(BuffData_t)Counter;
+	}
+
+	printf("%lu elements , bursts of %d elements , %d locations per buffer\n", Elements, BENCHMARK_BURST, BENCHMARK_BUFFER_SIZE);
+
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Elements; Done+=BENCHMARK_BURST)
+	{
+		for(Counter=0; Counter<BENCHMARK_BURST; Counter++)
+		{
+			CBuffer_PushData(&CBuffer, (BuffData_t)Counter);
+		}
+		for(Counter=0; Counter<BENCHMARK_BURST; Counter++)
+		{
+			CBuffer_PopData(&CBuffer, &Data);
+			Sum+=Data;
+		}
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("CBuffer_Push/PopData", Done, Benchmark_Seconds(Start));
+
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Elements; Done+=BENCHMARK_BURST)
+	{
+		for(Counter=0; Counter<BENCHMARK_BURST; Counter++)
+		{
+			SPSC_PushData(&SPSC, (BuffData_t)Counter);
+		}
+		for(Counter=0; Counter<BENCHMARK_BURST; Counter++)
+		{
+			SPSC_PopData(&SPSC, &Data);
+			Sum+=Data;
+		}
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("SPSC_Push/PopData", Done, Benchmark_Seconds(Start));
+
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Elements; Done+=BENCHMARK_BURST)
+	{
+		CBuffer_PushBlock(&CBuffer, Block, BENCHMARK_BURST);
+		CBuffer_PopBlock(&CBuffer, Block, BENCHMARK_BURST);
+		Sum+=Block[BENCHMARK_BURST-1];
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("CBuffer_Push/PopBlock", Done, Benchmark_Seconds(Start));
+
+	Sum=0;
+	Start=clock();
+	for(Done=0; Done<Elements; Done+=BENCHMARK_BURST)
+	{
+		SPSC_PushBlock(&SPSC, Block, BENCHMARK_BURST);
+		SPSC_PopBlock(&SPSC, Block, BENCHMARK_BURST);
+		Sum+=Block[BENCHMARK_BURST-1];
+	}
+	Benchmark_Sink=Sum;
+	Benchmark_Report("SPSC_Push/PopBlock", Done, Benchmark_Seconds(Start));
+
+	return 0;
+}
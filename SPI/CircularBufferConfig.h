@@ -5,7 +5,7 @@
 /*
 Date: 12/06/2021
 Author: Mohamed EL-Gallad
-Description : This header file will contain the main Circular Buffer configuration "Buffer size and buffer data type"
+Description : This header file will contain the main Circular Buffer configuration "buffer data type and size type"
 */
 #ifndef _CIRCULARBUFFERCONFIG_H_
 #define _CIRCULARBUFFERCONFIG_H_
@@ -14,10 +14,18 @@ Description : This header file will contain the main Circular Buffer configurati
 //#include "UART_Config.h"
 
 /*
-  The BUFFER_SIZE MACRO will define the buffer size
-  all the buffers that being created will have the same size defined by this MACRO
+  NOTE : the size of each CircularBuffer instance is set at init time by CBuffer_BufferInit() and of each SPSC_Buffer by SPSC_BufferInit()
+  the UART and SPI modules size their buffers using the macros in UART_Config.h and SPI_Config.h
 */
-#define BUFFER_SIZE   TX_RX_BUFFER_SIZE
+
+/*
+  CBuffSize_t MACRO will define the data type of the CircularBuffer sizes and counts
+  the UART and SPI ISR buffers are SPSC_Buffers with free running 8bit indices "up to 128 locations" so the 8bit sizes are enough
+  for the modules , it can be changed to u16 together with CBUFF_WIDE_SIZES for CircularBuffer instances of more than 255 locations
+  NOTE : the u16 counts can't be read or updated atomically so they are accessed with the global interrupt disabled
+*/
+#define CBuffSize_t  u8
+#define CBUFF_WIDE_SIZES  0  //1 if CBuffSize_t is u16 , the CircularBuffer counts are then read and updated with the global interrupt disabled
 
 /*
   BuffData_t MACRO will define the data type of the circular buffer elements "depending on the frame size"
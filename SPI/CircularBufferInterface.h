@@ -13,23 +13,29 @@ Description : This header file will contain interface functions for the Circular
 
 /*******************************************************************************************************
 CircularBuffer : is a struct that is being used to create a CircularBuffer instance .
-NOTE : all the created Buffers will have the size equals to BUFFER_SIZE MACROS
+NOTE : each Buffer instance uses a storage array that is provided by the user at init time
+so each instance can have it's own size "BufferSize" , the storage array MUST NOT be used by anything else
+in case of 16bit sizes the AvailablePosition is read and updated with the global interrupt disabled so it can't be torn by an ISR
+for buffers that are shared between an ISR and the main loop the SPSC_Buffer is preferred "no shared counter at all"
 *******************************************************************************************************/
 typedef struct {
-	volatile  BuffData_t data[BUFFER_SIZE];
+	volatile  BuffData_t *data;
 	volatile  BuffData_t *headptr;
 	volatile BuffData_t *tailptr;
-	volatile u8 AvailablePosition;
+	CBuffSize_t BufferSize;
+	volatile CBuffSize_t AvailablePosition;
 }CircularBuffer;
 
 
 /*******************************************************************************************************
 RETURN     : VOID
 PARAMETERS : BufferPtr is A pointer to the Circular Buffer instance
+           : Storage is a pointer to the array that will hold the buffer elements
+           : StorageSize is the number of elements of the Storage array "the buffer size , 1 to 255 or up to 65535 if CBuffSize_t is u16"
 DESCRIPTION: This function is used to initiate the circular buffer and it must be called before any opertion
 performed on a curcular buffer object
 *******************************************************************************************************/
-void CBuffer_BufferInit(CircularBuffer *BufferPtr);
+void CBuffer_BufferInit(CircularBuffer *BufferPtr, volatile BuffData_t *Storage, CBuffSize_t StorageSize);
 
 
 /*******************************************************************************************************
@@ -57,7 +63,7 @@ RETURN     : VOID
 PARAMETERS : BufferAddress is A pointer to the Circular Buffer instance
 DESCRIPTION: This function is used to clear the circular buffer instance
 after the execution headptr and tailptr will point at the first element in the buffer and AvailablePosition
-will equal BUFFER_SIZE
+will equal the buffer size
 *******************************************************************************************************/
 void CBuffer_BufferReset(CircularBuffer *BufferAddress);
 
@@ -77,4 +83,155 @@ DESCRIPTION: This function is used to check if either the buffer is full or not
 *******************************************************************************************************/
 u8 CBuffer_IsTheBufferFull(CircularBuffer *Buffer);
 
+
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of elements that have been pushed to the buffer
+PARAMETERS :Buffer ,is A pointer to the Circular Buffer instance
+           :Source , is a pointer to the array that contains the data to be stored in the buffer
+           :Count , is the number of elements to be pushed from the Source array
+DESCRIPTION:this function is used to push up to Count elements to the circular buffer in one call
+if the available space is less than Count only the elements that fit will be pushed
+the data is copied in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+CBuffSize_t CBuffer_PushBlock(CircularBuffer* Buffer, const BuffData_t *Source, CBuffSize_t Count);
+
+
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of elements that have been popped out of the buffer
+PARAMETERS :Buffer ,is A pointer to the Circular Buffer instance
+           :Destination , is a pointer to the array where the popped data will be stored
+           :Count , is the maximum number of elements to be popped
+DESCRIPTION:this function is used to pop up to Count elements out of the circular buffer in one call
+if the buffer contains less than Count elements all the stored elements will be popped
+the data is copied out in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+CBuffSize_t CBuffer_PopBlock(CircularBuffer* Buffer, BuffData_t *Destination, CBuffSize_t Count);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the error codes ERROR_BUFFER_EMPTY if the buffer is empty or
+SUCCESSFUL_OPERATION if the CBuffer_Peek has been executed successfully.
+PARAMETERS :Buffer ,is A pointer to the Circular Buffer instance
+           :DataPtr is a pointer to BuffData_t variable that will contain a copy of the oldest element in the buffer
+DESCRIPTION:this function is used to read the oldest element in the buffer without popping it out
+*******************************************************************************************************/
+u8 CBuffer_Peek(CircularBuffer* Buffer, BuffData_t *DataPtr);
+
+
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of elements stored in the buffer
+PARAMETERS : Buffer is A pointer to the Circular Buffer instance
+DESCRIPTION: This function is used to get the number of elements that are waiting to be popped
+*******************************************************************************************************/
+CBuffSize_t CBuffer_Count(CircularBuffer *Buffer);
+
+
+
+/*******************************************************************************************************
+SPSC_Buffer : is a struct that is being used to create a single producer single consumer buffer instance .
+the producer "ex. an ISR" writes only the HeadIndex and the consumer "ex. the main loop" writes only the TailIndex
+so no critical section is required when the buffer is shared between an ISR and the main loop.
+both indices are free running 8bit counters , the number of stored elements = HeadIndex - TailIndex and the storage
+location of an index is "Index & IndexMask" so there is no compare against the last element to wrap around
+NOTE : each SPSC Buffer instance uses a storage array that is provided by the user at init time , the array size MUST be
+a power of two value between 2 and 128 "checked at compile time by the module that owns the buffer" and the array MUST NOT be used by anything else
+*******************************************************************************************************/
+typedef struct {
+	volatile BuffData_t *data;
+	u8 IndexMask;
+	volatile u8 HeadIndex;
+	volatile u8 TailIndex;
+}SPSC_Buffer;
+
+
+
+/*******************************************************************************************************
+RETURN     : VOID
+PARAMETERS : BufferPtr is A pointer to the SPSC Buffer instance
+           : Storage is a pointer to the array that will hold the buffer elements
+           : BufferSize is the number of elements of the Storage array "power of two value between 2 and 128"
+DESCRIPTION: This function is used to initiate the SPSC buffer and it must be called before any operation
+performed on a SPSC buffer object
+*******************************************************************************************************/
+void SPSC_BufferInit(SPSC_Buffer *BufferPtr, volatile BuffData_t *Storage, u8 BufferSize);
+
+
+/*******************************************************************************************************
+RETURN     : VOID
+PARAMETERS : BufferPtr is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to clear the SPSC buffer instance
+CAUTION    : both indices are written so neither the producer nor the consumer may use the buffer meanwhile "ex. the ISR is disabled"
+*******************************************************************************************************/
+void SPSC_BufferReset(SPSC_Buffer *BufferPtr);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the error codes ERROR_BUFFER_FULL if the buffer is full or
+SUCCESSFUL_OPERATION if the SPSC_PushData has been executed successfully.
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :data , is copy of the data that is required to be stored in the buffer
+DESCRIPTION:this function is used by the producer ONLY to push data to the SPSC buffer if there is an available space in the buffer
+*******************************************************************************************************/
+u8 SPSC_PushData(SPSC_Buffer *Buffer, BuffData_t data);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the error codes ERROR_BUFFER_EMPTY if the buffer is empty or
+SUCCESSFUL_OPERATION if the SPSC_PopData has been executed successfully.
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :DataPtr is a pointer to BuffData_t variable that will contain the popped value out of the buffer
+DESCRIPTION:this function is used by the consumer ONLY to pop data out of the SPSC buffer
+*******************************************************************************************************/
+u8 SPSC_PopData(SPSC_Buffer *Buffer, BuffData_t *DataPtr);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the number of elements that have been pushed to the buffer
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :Source , is a pointer to the array that contains the data to be stored in the buffer
+           :Count , is the number of elements to be pushed from the Source array
+DESCRIPTION:this function is used by the producer ONLY to push up to Count elements in one call
+if the available space is less than Count only the elements that fit will be pushed
+the HeadIndex is published once after all the elements have been stored
+the data is copied in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+u8 SPSC_PushBlock(SPSC_Buffer *Buffer, const BuffData_t *Source, u8 Count);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the number of elements that have been popped out of the buffer
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :Destination , is a pointer to the array where the popped data will be stored
+           :Count , is the maximum number of elements to be popped
+DESCRIPTION:this function is used by the consumer ONLY to pop up to Count elements in one call
+if the buffer contains less than Count elements all the stored elements will be popped
+the TailIndex is published once after all the elements have been copied
+the data is copied out in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+u8 SPSC_PopBlock(SPSC_Buffer *Buffer, BuffData_t *Destination, u8 Count);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the number of elements stored in the SPSC buffer
+PARAMETERS : Buffer is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to get the number of elements that are waiting to be popped
+*******************************************************************************************************/
+u8 SPSC_Count(SPSC_Buffer *Buffer);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value either TRUE if the buffer is empty or FALSE if the buffer isn't empty
+PARAMETERS : Buffer is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to check if either the SPSC buffer is empty or not
+*******************************************************************************************************/
+u8 SPSC_IsTheBufferEmpty(SPSC_Buffer *Buffer);
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value either TRUE if the buffer is full or FALSE if the buffer isn't full
+PARAMETERS : Buffer is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to check if either the SPSC buffer is full or not
+*******************************************************************************************************/
+u8 SPSC_IsTheBufferFull(SPSC_Buffer *Buffer);
+
 #endif
@@ -5,24 +5,76 @@ Description : This file will contain the functions implementation for the circul
 */
 #include "STD_types.h"
 
+#include "Mega32_reg.h"
+#include "REG_utils.h"
 #include "CircularBufferInterface.h"
 
 
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of the available positions in the buffer
+PARAMETERS : Buffer is A pointer to the Circular Buffer instance
+DESCRIPTION: static function that is used to read the AvailablePosition that may be updated by an ISR meanwhile
+in case of 16bit sizes the two bytes are read with the global interrupt disabled so the value can't be torn by an ISR
+*******************************************************************************************************/
+static CBuffSize_t CBuffer_ReadAvailable(CircularBuffer *Buffer)
+{
+#if CBUFF_WIDE_SIZES == 1
+	CBuffSize_t Available;
+	u8 SREG_Copy=SREG;
+	ClearRegisterBit(SREG, 7);
+	Available=Buffer->AvailablePosition;
+	SREG=SREG_Copy; //restore the global interrupt state
+	return Available;
+#else
+	return Buffer->AvailablePosition;
+#endif
+}
+
+
+/*******************************************************************************************************
+RETURN     : VOID
+PARAMETERS : Buffer is A pointer to the Circular Buffer instance
+           : Count is the number of the pushed or popped elements
+           : Popped is TRUE if the elements have been popped "the available positions increase" or FALSE if they have been pushed
+DESCRIPTION: static function that is used to update the AvailablePosition after a push or a pop operation
+in case of 16bit sizes the read modify write is done with the global interrupt disabled so it can't be torn by an ISR
+*******************************************************************************************************/
+static void CBuffer_UpdateAvailable(CircularBuffer *Buffer, CBuffSize_t Count, u8 Popped)
+{
+#if CBUFF_WIDE_SIZES == 1
+	u8 SREG_Copy=SREG;
+	ClearRegisterBit(SREG, 7);
+#endif
+	if(Popped)
+	{
+		Buffer->AvailablePosition+=Count;
+	}
+	else
+	{
+		Buffer->AvailablePosition-=Count;
+	}
+#if CBUFF_WIDE_SIZES == 1
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
+}
+
+
 
 /*******************************************************************************************************
 RETURN     : VOID
 PARAMETERS : BufferPtr is A pointer to the Circular Buffer instance
+           : Storage is a pointer to the array that will hold the buffer elements
+           : StorageSize is the number of elements of the Storage array "the buffer size , 1 to 255 or up to 65535 if CBuffSize_t is u16"
 DESCRIPTION: This function is used to initiate the circular buffer and it must be called before any opertion
 performed on a curcular buffer object
 *******************************************************************************************************/
-void CBuffer_BufferInit(CircularBuffer *BufferPtr)
+void CBuffer_BufferInit(CircularBuffer *BufferPtr, volatile BuffData_t *Storage, CBuffSize_t StorageSize)
 {
-	//set the headptr pointer to the first ever location of the buffer 
-    BufferPtr->headptr=BufferPtr->data;
-	//set the tailptr pointer to the first ever location of the buffer
-    BufferPtr->tailptr=BufferPtr->data;
-	//make the AvailablePosition value equals the BUFFER_SIZE MACRO 
-    BufferPtr->AvailablePosition =BUFFER_SIZE;
+	//attach the user's storage array and it's size to the buffer instance
+    BufferPtr->data=Storage;
+    BufferPtr->BufferSize=StorageSize;
+	//set the head and tail pointers and the available positions to their initial values
+    CBuffer_BufferReset(BufferPtr);
 }
 
 
@@ -38,16 +90,16 @@ u8 CBuffer_PushData(CircularBuffer* Buffer ,BuffData_t data)
 	//PushDataError will hold the error value either ERROR_BUFFER_FULL or SUCCESSFUL_OPERATION
 	u8 PushDataError;
 	//check if there is an available space in the buffer or not
-    if(Buffer->AvailablePosition>0)
+    if(CBuffer_ReadAvailable(Buffer)>0)
     {
 	//store the data at the available space 
 	*(Buffer->headptr)=data;
 	//set the error value to SUCCESSFUL_OPERATION as the data has been stored successfully 
 	PushDataError=SUCCESSFUL_OPERATION;
 	//decrease the available spaces in the buffer by 1
-    Buffer->AvailablePosition--;
+    CBuffer_UpdateAvailable(Buffer, 1, FALSE);
 	//check if the headptr has the value of the last available space in the buffer if so set the headptr to point at the firt element of the buffer
-	    if(Buffer->headptr == &Buffer->data[BUFFER_SIZE-1])
+	    if(Buffer->headptr == &Buffer->data[Buffer->BufferSize-1])
 	     {
 			 //set the headptr value to the first element of the buffer
 		    Buffer->headptr =Buffer->data;
@@ -80,16 +132,16 @@ u8 CBuffer_PopData(CircularBuffer* Buffer,  BuffData_t *DataPtr)
 	//PopDataError will hold the error value either ERROR_BUFFER_EMPTY or SUCCESSFUL_OPERATION
 	u8 PopDataError;
 	//check if the buffer is empty or not
-	if(Buffer->AvailablePosition < BUFFER_SIZE)
+	if(CBuffer_ReadAvailable(Buffer) < Buffer->BufferSize)
 	{
 	//pop the data where the tailptr points at
     *DataPtr=*(Buffer->tailptr);
 	//set the error value to SUCCESSFUL_OPERATION as the data has been popped successfully 
 	PopDataError =SUCCESSFUL_OPERATION;
 	//increase the available positions in the circular buffer by 1
-    Buffer->AvailablePosition++;
+    CBuffer_UpdateAvailable(Buffer, 1, TRUE);
 	//check if the tailptr has the value of the last available space in the buffer if so set the tailptr to point at the firt element of the buffer
-	 if(Buffer->tailptr == &Buffer->data[BUFFER_SIZE-1])
+	 if(Buffer->tailptr == &Buffer->data[Buffer->BufferSize-1])
 	     {
 			 //set the tailptr value to the first element of the buffer
 		    Buffer->tailptr =Buffer->data;
@@ -115,12 +167,23 @@ RETURN     : VOID
 PARAMETERS : BufferAddress is A pointer to the Circular Buffer instance
 DESCRIPTION: This function is used to clear the circular buffer instance
 after the execution headptr and tailptr will point at the first element in the buffer and AvailablePosition
-will equal BUFFER_SIZE
+will equal the buffer size
 *******************************************************************************************************/
 void CBuffer_BufferReset(CircularBuffer *BufferAddress)
 {
-	//calling CBuffer_BufferInit will reset the buffer to the initial values
-	CBuffer_BufferInit(BufferAddress);
+#if CBUFF_WIDE_SIZES == 1
+	u8 SREG_Copy=SREG;
+	ClearRegisterBit(SREG, 7); //the 16bit AvailablePosition is written with the global interrupt disabled
+#endif
+	//set the headptr pointer to the first ever location of the buffer
+    BufferAddress->headptr=BufferAddress->data;
+	//set the tailptr pointer to the first ever location of the buffer
+    BufferAddress->tailptr=BufferAddress->data;
+	//make the AvailablePosition value equals the buffer size
+    BufferAddress->AvailablePosition =BufferAddress->BufferSize;
+#if CBUFF_WIDE_SIZES == 1
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
 }
 
 
@@ -133,8 +196,8 @@ u8 CBuffer_IsTheBufferEmpty(CircularBuffer *Buffer)
 {
 	//a flag that will have a value of either TRUE or FALSE
 	u8 EmptyFlag;
-	//check if the AvailablePosition variable = BUFFER_SIZE "which means that the buffer is empty"
-	if(Buffer->AvailablePosition==BUFFER_SIZE)
+	//check if the AvailablePosition variable = the buffer size "which means that the buffer is empty"
+	if(CBuffer_ReadAvailable(Buffer)==Buffer->BufferSize)
 	{
 		//set the flag value to TRUE as the buffer is empty
 		EmptyFlag=TRUE;
@@ -159,7 +222,7 @@ u8 CBuffer_IsTheBufferFull(CircularBuffer *Buffer)
 	//a flag that will have a value of either TRUE or FALSE
 	u8 FullFlag;
 	//check if the AvailablePosition variable =0 "which means that the buffer is full"
-	if(Buffer->AvailablePosition==0)
+	if(CBuffer_ReadAvailable(Buffer)==0)
 	{
 		//set the flag value to TRUE as the buffer is full
 		FullFlag=TRUE;
@@ -172,3 +235,338 @@ u8 CBuffer_IsTheBufferFull(CircularBuffer *Buffer)
 	//return the flag value
 	return FullFlag;
 }
+
+
+
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of elements that have been pushed to the buffer
+PARAMETERS :Buffer ,is A pointer to the Circular Buffer instance
+           :Source , is a pointer to the array that contains the data to be stored in the buffer
+           :Count , is the number of elements to be pushed from the Source array
+DESCRIPTION:this function is used to push up to Count elements to the circular buffer in one call
+if the available space is less than Count only the elements that fit will be pushed
+the data is copied in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+CBuffSize_t CBuffer_PushBlock(CircularBuffer* Buffer, const BuffData_t *Source, CBuffSize_t Count)
+{
+	//PushedCount will hold the number of elements that have been pushed so far
+	CBuffSize_t PushedCount=0;
+	//SegmentLength will hold the number of elements that can be copied before reaching the wrap point
+	CBuffSize_t SegmentLength;
+	CBuffSize_t Index;
+	//the available space is read once , it can only grow meanwhile if the other side is an ISR that pops
+	CBuffSize_t Available=CBuffer_ReadAvailable(Buffer);
+	//only the elements that fit in the available space will be pushed
+	if(Count > Available)
+	{
+		Count=Available;
+	}
+	//the loop body will be executed twice at most "once before the wrap point and once after it"
+	while(PushedCount < Count)
+	{
+		SegmentLength=(CBuffSize_t)(&Buffer->data[Buffer->BufferSize] - Buffer->headptr);
+		if(SegmentLength > (CBuffSize_t)(Count-PushedCount))
+		{
+			SegmentLength=Count-PushedCount;
+		}
+		for(Index=0;Index<SegmentLength;Index++)
+		{
+			Buffer->headptr[Index]=Source[PushedCount+Index];
+		}
+		Buffer->headptr+=SegmentLength;
+		//if the headptr passed the last element of the buffer set it to point at the first element of the buffer
+		if(Buffer->headptr == &Buffer->data[Buffer->BufferSize])
+		{
+			Buffer->headptr=Buffer->data;
+		}
+		PushedCount+=SegmentLength;
+	}
+	//decrease the available spaces in the buffer by the number of pushed elements "single update for the whole block"
+	CBuffer_UpdateAvailable(Buffer, PushedCount, FALSE);
+	//return the number of pushed elements
+	return PushedCount;
+}
+
+
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of elements that have been popped out of the buffer
+PARAMETERS :Buffer ,is A pointer to the Circular Buffer instance
+           :Destination , is a pointer to the array where the popped data will be stored
+           :Count , is the maximum number of elements to be popped
+DESCRIPTION:this function is used to pop up to Count elements out of the circular buffer in one call
+if the buffer contains less than Count elements all the stored elements will be popped
+the data is copied out in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+CBuffSize_t CBuffer_PopBlock(CircularBuffer* Buffer, BuffData_t *Destination, CBuffSize_t Count)
+{
+	//PoppedCount will hold the number of elements that have been popped so far
+	CBuffSize_t PoppedCount=0;
+	//SegmentLength will hold the number of elements that can be copied before reaching the wrap point
+	CBuffSize_t SegmentLength;
+	CBuffSize_t Index;
+	//the number of stored elements is read once , it can only grow meanwhile if the other side is an ISR that pushes
+	CBuffSize_t Stored=CBuffer_Count(Buffer);
+	//only the stored elements can be popped
+	if(Count > Stored)
+	{
+		Count=Stored;
+	}
+	//the loop body will be executed twice at most "once before the wrap point and once after it"
+	while(PoppedCount < Count)
+	{
+		SegmentLength=(CBuffSize_t)(&Buffer->data[Buffer->BufferSize] - Buffer->tailptr);
+		if(SegmentLength > (CBuffSize_t)(Count-PoppedCount))
+		{
+			SegmentLength=Count-PoppedCount;
+		}
+		for(Index=0;Index<SegmentLength;Index++)
+		{
+			Destination[PoppedCount+Index]=Buffer->tailptr[Index];
+		}
+		Buffer->tailptr+=SegmentLength;
+		//if the tailptr passed the last element of the buffer set it to point at the first element of the buffer
+		if(Buffer->tailptr == &Buffer->data[Buffer->BufferSize])
+		{
+			Buffer->tailptr=Buffer->data;
+		}
+		PoppedCount+=SegmentLength;
+	}
+	//increase the available positions in the buffer by the number of popped elements "single update for the whole block"
+	CBuffer_UpdateAvailable(Buffer, PoppedCount, TRUE);
+	//return the number of popped elements
+	return PoppedCount;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the error codes ERROR_BUFFER_EMPTY if the buffer is empty or
+SUCCESSFUL_OPERATION if the CBuffer_Peek has been executed successfully.
+PARAMETERS :Buffer ,is A pointer to the Circular Buffer instance
+           :DataPtr is a pointer to BuffData_t variable that will contain a copy of the oldest element in the buffer
+DESCRIPTION:this function is used to read the oldest element in the buffer without popping it out
+*******************************************************************************************************/
+u8 CBuffer_Peek(CircularBuffer* Buffer, BuffData_t *DataPtr)
+{
+	//PeekDataError will hold the error value either ERROR_BUFFER_EMPTY or SUCCESSFUL_OPERATION
+	u8 PeekDataError=ERROR_BUFFER_EMPTY;
+	if(CBuffer_ReadAvailable(Buffer) < Buffer->BufferSize)
+	{
+		//copy the data where the tailptr points at without advancing the tailptr
+		*DataPtr=*(Buffer->tailptr);
+		PeekDataError=SUCCESSFUL_OPERATION;
+	}
+	//return the error value
+	return PeekDataError;
+}
+
+
+/*******************************************************************************************************
+RETURN     : CBuffSize_t value represents the number of elements stored in the buffer
+PARAMETERS : Buffer is A pointer to the Circular Buffer instance
+DESCRIPTION: This function is used to get the number of elements that are waiting to be popped
+*******************************************************************************************************/
+CBuffSize_t CBuffer_Count(CircularBuffer *Buffer)
+{
+	return (CBuffSize_t)(Buffer->BufferSize - CBuffer_ReadAvailable(Buffer));
+}
+
+
+/*******************************************************************************************************
+RETURN     : VOID
+PARAMETERS : BufferPtr is A pointer to the SPSC Buffer instance
+           : Storage is a pointer to the array that will hold the buffer elements
+           : BufferSize is the number of elements of the Storage array "power of two value between 2 and 128"
+DESCRIPTION: This function is used to initiate the SPSC buffer and it must be called before any operation
+performed on a SPSC buffer object
+*******************************************************************************************************/
+void SPSC_BufferInit(SPSC_Buffer *BufferPtr, volatile BuffData_t *Storage, u8 BufferSize)
+{
+	//attach the user's storage array , the mask maps the free running indices to the storage locations
+	BufferPtr->data=Storage;
+	BufferPtr->IndexMask=BufferSize-1;
+	SPSC_BufferReset(BufferPtr);
+}
+
+
+/*******************************************************************************************************
+RETURN     : VOID
+PARAMETERS : BufferPtr is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to clear the SPSC buffer instance
+CAUTION    : both indices are written so neither the producer nor the consumer may use the buffer meanwhile "ex. the ISR is disabled"
+*******************************************************************************************************/
+void SPSC_BufferReset(SPSC_Buffer *BufferPtr)
+{
+	//both indices have the same value which means that the buffer is empty
+	BufferPtr->HeadIndex=0;
+	BufferPtr->TailIndex=0;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the error codes ERROR_BUFFER_FULL if the buffer is full or
+SUCCESSFUL_OPERATION if the SPSC_PushData has been executed successfully.
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :data , is copy of the data that is required to be stored in the buffer
+DESCRIPTION:this function is used by the producer ONLY to push data to the SPSC buffer if there is an available space in the buffer
+*******************************************************************************************************/
+u8 SPSC_PushData(SPSC_Buffer *Buffer, BuffData_t data)
+{
+	//PushDataError will hold the error value either ERROR_BUFFER_FULL or SUCCESSFUL_OPERATION
+	u8 PushDataError=ERROR_BUFFER_FULL;
+	//local copy of the producer's index , it's only written here so it can't be changed by the consumer
+	u8 Head=Buffer->HeadIndex;
+	//the 8bit subtraction gives the number of stored elements even after the indices wrap around
+	if((u8)(Head - Buffer->TailIndex) <= Buffer->IndexMask)
+	{
+		//store the data first then publish it to the consumer by advancing the HeadIndex
+		Buffer->data[Head & Buffer->IndexMask]=data;
+		Buffer->HeadIndex=Head+1;
+		PushDataError=SUCCESSFUL_OPERATION;
+	}
+	//return the error value
+	return PushDataError;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the error codes ERROR_BUFFER_EMPTY if the buffer is empty or
+SUCCESSFUL_OPERATION if the SPSC_PopData has been executed successfully.
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :DataPtr is a pointer to BuffData_t variable that will contain the popped value out of the buffer
+DESCRIPTION:this function is used by the consumer ONLY to pop data out of the SPSC buffer
+*******************************************************************************************************/
+u8 SPSC_PopData(SPSC_Buffer *Buffer, BuffData_t *DataPtr)
+{
+	//PopDataError will hold the error value either ERROR_BUFFER_EMPTY or SUCCESSFUL_OPERATION
+	u8 PopDataError=ERROR_BUFFER_EMPTY;
+	//local copy of the consumer's index , it's only written here so it can't be changed by the producer
+	u8 Tail=Buffer->TailIndex;
+	if(Tail != Buffer->HeadIndex)
+	{
+		//read the data first then release the slot to the producer by advancing the TailIndex
+		*DataPtr=Buffer->data[Tail & Buffer->IndexMask];
+		Buffer->TailIndex=Tail+1;
+		PopDataError=SUCCESSFUL_OPERATION;
+	}
+	//return the error value
+	return PopDataError;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the number of elements that have been pushed to the buffer
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :Source , is a pointer to the array that contains the data to be stored in the buffer
+           :Count , is the number of elements to be pushed from the Source array
+DESCRIPTION:this function is used by the producer ONLY to push up to Count elements in one call
+if the available space is less than Count only the elements that fit will be pushed
+the HeadIndex is published once after all the elements have been stored
+the data is copied in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+u8 SPSC_PushBlock(SPSC_Buffer *Buffer, const BuffData_t *Source, u8 Count)
+{
+	u8 Head=Buffer->HeadIndex;
+	//the TailIndex is read once , the consumer can only free more locations meanwhile
+	u8 Available=(u8)(Buffer->IndexMask + 1 - (u8)(Head - Buffer->TailIndex));
+	//Offset is the storage location of the HeadIndex and SegmentLength is the number of elements that fit before the wrap point
+	u8 Offset=Head & Buffer->IndexMask;
+	u8 SegmentLength=(u8)(Buffer->IndexMask + 1 - Offset);
+	u8 Index;
+	//only the elements that fit in the available space will be pushed
+	if(Count > Available)
+	{
+		Count=Available;
+	}
+	if(SegmentLength > Count)
+	{
+		SegmentLength=Count;
+	}
+	//the data is copied in at most two contiguous parts "before and after the wrap point"
+	for(Index=0;Index<SegmentLength;Index++)
+	{
+		Buffer->data[Offset+Index]=Source[Index];
+	}
+	for(Index=SegmentLength;Index<Count;Index++)
+	{
+		Buffer->data[Index-SegmentLength]=Source[Index];
+	}
+	//publish all the stored elements to the consumer at once
+	Buffer->HeadIndex=Head+Count;
+	return Count;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the number of elements that have been popped out of the buffer
+PARAMETERS :Buffer ,is A pointer to the SPSC Buffer instance
+           :Destination , is a pointer to the array where the popped data will be stored
+           :Count , is the maximum number of elements to be popped
+DESCRIPTION:this function is used by the consumer ONLY to pop up to Count elements in one call
+if the buffer contains less than Count elements all the stored elements will be popped
+the TailIndex is published once after all the elements have been copied
+the data is copied out in at most two contiguous parts "before and after the buffer's wrap point"
+*******************************************************************************************************/
+u8 SPSC_PopBlock(SPSC_Buffer *Buffer, BuffData_t *Destination, u8 Count)
+{
+	u8 Tail=Buffer->TailIndex;
+	//the HeadIndex is read once , the producer can only store more elements meanwhile
+	u8 Stored=(u8)(Buffer->HeadIndex - Tail);
+	//Offset is the storage location of the TailIndex and SegmentLength is the number of elements that can be read before the wrap point
+	u8 Offset=Tail & Buffer->IndexMask;
+	u8 SegmentLength=(u8)(Buffer->IndexMask + 1 - Offset);
+	u8 Index;
+	//only the stored elements can be popped
+	if(Count > Stored)
+	{
+		Count=Stored;
+	}
+	if(SegmentLength > Count)
+	{
+		SegmentLength=Count;
+	}
+	//the data is copied out in at most two contiguous parts "before and after the wrap point"
+	for(Index=0;Index<SegmentLength;Index++)
+	{
+		Destination[Index]=Buffer->data[Offset+Index];
+	}
+	for(Index=SegmentLength;Index<Count;Index++)
+	{
+		Destination[Index]=Buffer->data[Index-SegmentLength];
+	}
+	//release all the copied locations to the producer at once
+	Buffer->TailIndex=Tail+Count;
+	return Count;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value represents the number of elements stored in the SPSC buffer
+PARAMETERS : Buffer is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to get the number of elements that are waiting to be popped
+*******************************************************************************************************/
+u8 SPSC_Count(SPSC_Buffer *Buffer)
+{
+	return (u8)(Buffer->HeadIndex - Buffer->TailIndex);
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value either TRUE if the buffer is empty or FALSE if the buffer isn't empty
+PARAMETERS : Buffer is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to check if either the SPSC buffer is empty or not
+*******************************************************************************************************/
+u8 SPSC_IsTheBufferEmpty(SPSC_Buffer *Buffer)
+{
+	return (Buffer->HeadIndex == Buffer->TailIndex) ? TRUE : FALSE;
+}
+
+
+/*******************************************************************************************************
+RETURN     : unsigned char value either TRUE if the buffer is full or FALSE if the buffer isn't full
+PARAMETERS : Buffer is A pointer to the SPSC Buffer instance
+DESCRIPTION: This function is used to check if either the SPSC buffer is full or not
+*******************************************************************************************************/
+u8 SPSC_IsTheBufferFull(SPSC_Buffer *Buffer)
+{
+	return ((u8)(Buffer->HeadIndex - Buffer->TailIndex) > Buffer->IndexMask) ? TRUE : FALSE;
+}
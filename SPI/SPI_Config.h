@@ -14,11 +14,26 @@
  *  	        C- The selection of the clock phase and polarity
  *  	        D- The value of the Dummy packet by setting the macro DUMMY_PACKET to the desired value
  *  	        E- The order of data transmission to be either LSB or MSB first
+ *  	        F- Select to either enable or disable the interrupt driven asynchronous transfers by setting the SPI_MASTER_ASYNC_TRANSFER macro
+ *  	        G- Select to either enable or disable the multi device transaction queue by setting the SPI_TRANSACTION_QUEUE macro
+ *  	           each device is described by a SPI_Device_t "CS pin , clock mode , speed and data order" so the above master frequency ,
+ *  	           clock mode and data order settings are only the defaults used by SPI_Init() , the queued transactions run back to back
+ *  	           from the ISR and the device settings are written to SPCR and SPSR only when the bus switches to another device
  *
  *  	   1-2- If the node configured as Slave the user has to set the following configurations
- *  	   		A- The size of the TX and RX buffers by setting the value of the macro TX_RX_BUFFER_SIZE
- *  	   		NOTE: this macro is shared with the UART module so if both module is used at the same time
- *  	   		the value of that macro must be the same in both modules
+ *  	   		A- The size of the TX and RX buffers by setting the value of the macros SPI_TX_BUFFER_SIZE and SPI_RX_BUFFER_SIZE
+ *  	   		"power of two value between 2 and 128 locations each"
+ *  	   		NOTE: each buffer costs "BufferSize" bytes of storage + 5bytes of control data "storage pointer 2bytes +
+ *  	   		index mask , head and tail indices 1byte each"
+ *  	   		ex. 64 RX locations and 16 TX locations cost (64+5)+(16+5) = 90bytes while the old shared
+ *  	   		TX_RX_BUFFER_SIZE of 64 used to cost 2x(64+5) = 138bytes
+ *  	   		the TX buffer also costs 1bit per location + 1 for the receive/drop flags of the shifted out bytes "3bytes for 16 locations"
+ *  	   		B- Select to either enable or disable the register map mode by setting the SPI_SLAVE_REGISTER_MAP macro
+ *  	   		in this mode the TX and RX buffers aren't used , the SPI ISR decodes a command byte "SPI_REGMAP_READ_CMD or SPI_REGMAP_WRITE_CMD"
+ *  	   		followed by a register address byte then streams the data bytes from or into the user's register array with auto-increment
+ *  	   		the end of each transaction "SS rising edge" MUST be reported by calling SPI_SlaveRegMapEndOfTransaction() ex. from an external
+ *  	   		interrupt ISR wired to the SS line , the master MUST leave a gap of the slave ISR latency after the address byte of a read command
+ *  	   		so the first register value is loaded to SPDR before it's shifted out
  */
 
 #ifndef SPI_CONFIG_H_
@@ -83,6 +98,21 @@
 
 #define DATA_ORDER  TRANSMIT_MSB_FIRST
 
+
+                                 /*-------------------------------*
+                                  *    MASTER ASYNC TRANSFERS     *
+                                  *-------------------------------*/
+//when enabled SPI_MasterTransferAsync() will send and receive whole buffers driven by the SPI transfer complete interrupt
+#define SPI_MASTER_ASYNC_TRANSFER  DISABLE // Set to either DISABLE or ENABLE Macros
+
+
+                                 /*-------------------------------*
+                                  *  MASTER TRANSACTION QUEUE     *
+                                  *-------------------------------*/
+//when enabled SPI_QueueTransaction() will queue transactions to several devices "requires SPI_MASTER_ASYNC_TRANSFER"
+#define SPI_TRANSACTION_QUEUE       DISABLE // Set to either DISABLE or ENABLE Macros
+#define SPI_TRANSACTION_QUEUE_SIZE  4       //number of queued transactions "power of two value between 2 and 128"
+
 /**************************************************************************************************************/
 
 
@@ -94,9 +124,18 @@
                                   *   SLAVE TX & RX BUFFER SIZE   *
                                   *-------------------------------*/
 
-#ifndef TX_RX_BUFFER_SIZE
-#define TX_RX_BUFFER_SIZE  (7)
-#endif
+#define SPI_TX_BUFFER_SIZE  8  //TX buffer size control "Number of available locations in buffer , power of two 2 to 128"
+#define SPI_RX_BUFFER_SIZE  8  //RX buffer size control "Number of available locations in buffer , power of two 2 to 128"
+
+
+                                 /*-------------------------------*
+                                  *      SLAVE REGISTER MAP       *
+                                  *-------------------------------*/
+#define SPI_SLAVE_REGISTER_MAP  DISABLE // Set to either DISABLE or ENABLE Macros
+#define SPI_REGMAP_READ_CMD     ((u8)0x03) //command byte of the register read transaction
+#define SPI_REGMAP_WRITE_CMD    ((u8)0x02) //command byte of the register write transaction
+#define SPI_REGMAP_FILL_BYTE    ((u8)0xFF) //the byte shifted out while no register value is being read
+
 /**************************************************************************************************************/
 
 #endif /* SPI_CONFIG_H_ */
@@ -20,6 +20,19 @@
  *
  *  6- in case of slave mode the received data will be automatically save in the circular buffer and to read the received data the
  *  user will have to call this function SPI_SlaveReadByteFromRXBuffer().
+ *
+ *  7- if SPI_MASTER_ASYNC_TRANSFER is enabled the master can send and receive a whole buffer by calling SPI_MasterTransferAsync()
+ *  the transfer is driven by the SPI transfer complete interrupt so the CPU is free while the bytes are being shifted .
+ *
+ *  8- at the high SPI clock rates "ex. CPU_FREQ_DIV_BY4 with the double speed mode" the byte time is shorter than the interrupt overhead
+ *  so the master should use the polled SPI_MasterBurst() , SPI_MasterBurstWrite() and SPI_MasterBurstRead() functions instead .
+ *
+ *  9- if SPI_TRANSACTION_QUEUE is enabled several devices can share the bus , each device is described once by SPI_DeviceInit()
+ *  and the transactions are queued by SPI_QueueTransaction() , the queued transactions are executed back to back from the ISR .
+ *
+ *  10- if SPI_SLAVE_REGISTER_MAP is enabled the slave exposes the user's register array set by SPI_SlaveRegMapInit() to the master ,
+ *  each transaction is "command byte , address byte , data bytes" and it's handled completely by the SPI ISR , the buffered slave
+ *  functions aren't available in this mode and SPI_SlaveRegMapEndOfTransaction() MUST be called on each SS rising edge .
  */
 
 #ifndef SPI_INTERFACE_H_
@@ -29,6 +42,37 @@
 #include "SPI_Private.h"
 
 
+/*
+  SPI_Device_t is used to describe a device on the SPI bus , it MUST be filled by SPI_DeviceInit()
+  CS_Port , CS_Pin : the DIO port "0 to 3 for PORTA to PORTD" and pin number of the device chip select pin "active low"
+  SPCR_Value       : the precomputed SPCR register value "clock mode , speed and data order" of the device
+  SPSR_Value       : the precomputed SPSR register value "double speed mode" of the device
+*/
+typedef struct {
+	u8 CS_Port;
+	u8 CS_Pin;
+	u8 SPCR_Value;
+	u8 SPSR_Value;
+}SPI_Device_t;
+
+
+/*
+  SPI_Transaction_t is used to describe a queued transaction
+  Device   : pointer to the device descriptor "it MUST stay valid as long as it's used by the queued transactions"
+  TX_Data  : pointer to the bytes to be sent , NULL sends the DUMMY_PACKET
+  RX_Data  : pointer to where the received bytes will be stored , NULL discards the received bytes
+  Length   : number of bytes to be transferred "the CS pin stays low for the whole transaction"
+  TransactionComplete_UserFunction : pointer to the user's function to be executed "from the ISR" at the end of the transaction or NULL
+*/
+typedef struct {
+	const SPI_Device_t *Device;
+	const u8 *TX_Data;
+	u8 *RX_Data;
+	u16 Length;
+	void (*TransactionComplete_UserFunction)(void);
+}SPI_Transaction_t;
+
+
 /**
  *  RETURN     : VOID
  *  PARAMETERS : VOID
@@ -51,6 +95,97 @@ void SPI_Init(void);
 u8 SPI_MasterSendAndReceiveByte( u8 SendData);
 
 
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the transfer has been started
+ * 				 SPI_TRANSFER_BUSY    : the previous asynchronous transfer hasn't been finished yet
+ * 				 FAILED_OPERATION     : Length equals zero , the node isn't a master or SPI_MASTER_ASYNC_TRANSFER is disabled
+ * PARAMETERS  : TX_Data is a pointer to the bytes to be sent , if it's NULL the DUMMY_PACKET is sent instead "receive only transfer"
+ * 				 RX_Data is a pointer to where the received bytes will be stored , if it's NULL the received bytes are discarded "transmit only transfer"
+ * 				 Length is the number of bytes to be transferred
+ * 				 TransferComplete_UserFunction is a pointer to a user defined function to be executed "from the ISR" once the last byte
+ * 				 has been received , it can be NULL if no notification is required
+ * DESCRIPTION : This function is used ONLY when the node is configured as master to transfer a whole buffer without waiting ,
+ * 				 the SS pin is pulled low for the whole transfer and the bytes are shifted one at a time by the SPI transfer complete interrupt
+ * CAUTION     : the TX_Data and RX_Data arrays MUST stay valid till the transfer is finished and SPI_MasterSendAndReceiveByte() MUST NOT be
+ * 				 called during the transfer , the global interrupt MUST be enabled "it's left as it is so the function can be called from
+ * 				 the TransferComplete_UserFunction to chain the next transfer" , the transfer always uses the SPI_Init() settings
+ */
+u8 SPI_MasterTransferAsync(const u8 *TX_Data, u8 *RX_Data, u16 Length, void (*TransferComplete_UserFunction)(void));
+
+
+/**
+ * RETURN      : u8 variable that will be TRUE while an asynchronous transfer is in progress or FALSE otherwise
+ * PARAMETERS  : VOID
+ * DESCRIPTION : This function is used to check if the last SPI_MasterTransferAsync() transfer has been finished
+ */
+u8 SPI_MasterTransferBusy(void);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the bytes have been transferred
+ * 				 SPI_TRANSFER_BUSY    : an asynchronous transfer is in progress so nothing has been transferred
+ * 				 FAILED_OPERATION     : Length equals zero or the node isn't a master
+ * PARAMETERS  : TX_Data is a pointer to the bytes to be sent
+ * 				 RX_Data is a pointer to where the received bytes will be stored "it can be the same array as TX_Data"
+ * 				 Length is the number of bytes to be transferred
+ * DESCRIPTION : This function is used ONLY when the node is configured as master to transfer a whole buffer by a tight polling loop ,
+ * 				 the SS pin is pulled low for the whole burst and the next byte is fetched while the current one is being shifted so SPDR
+ * 				 is reloaded right after SPIF is set , it's intended for the high SPI clock rates where the interrupt overhead exceeds the byte time
+ */
+u8 SPI_MasterBurst(const u8 *TX_Data, u8 *RX_Data, u16 Length);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the bytes have been transferred
+ * 				 SPI_TRANSFER_BUSY    : an asynchronous transfer is in progress so nothing has been transferred
+ * 				 FAILED_OPERATION     : Length equals zero or the node isn't a master
+ * PARAMETERS  : TX_Data is a pointer to the bytes to be sent , Length is the number of bytes to be sent
+ * DESCRIPTION : This function is the transmit only version of SPI_MasterBurst() , the received bytes are discarded
+ */
+u8 SPI_MasterBurstWrite(const u8 *TX_Data, u16 Length);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the bytes have been transferred
+ * 				 SPI_TRANSFER_BUSY    : an asynchronous transfer is in progress so nothing has been transferred
+ * 				 FAILED_OPERATION     : Length equals zero or the node isn't a master
+ * PARAMETERS  : RX_Data is a pointer to where the received bytes will be stored , Length is the number of bytes to be received
+ * DESCRIPTION : This function is the receive only version of SPI_MasterBurst() , the DUMMY_PACKET is sent for each received byte
+ */
+u8 SPI_MasterBurstRead(u8 *RX_Data, u16 Length);
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : Device is a pointer to the device descriptor to be filled
+ * 				 CS_Port and CS_Pin are the DIO port "0 to 3" and pin number of the device chip select pin
+ * 				 ClockMode is one of the CLK_PHASE_POLARITY_MODE_x Macros
+ * 				 MasterFreq is one of the CPU_FREQ_DIV_BYx Macros
+ * 				 DoubleSpeed is either ENABLE or DISABLE Macros
+ * 				 DataOrder is either TRANSMIT_LSB_FIRST or TRANSMIT_MSB_FIRST Macros
+ * DESCRIPTION : This function is used to describe a device on the SPI bus , the SPCR and SPSR values of the device are computed once
+ * 				 and the CS pin is configured as an output in the high "deselected" state
+ */
+void SPI_DeviceInit(SPI_Device_t *Device, u8 CS_Port, u8 CS_Pin, u8 ClockMode, u8 MasterFreq, u8 DoubleSpeed, u8 DataOrder);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the transaction has been queued "or started if the bus was idle"
+ * 				 ERROR_BUFFER_FULL    : the transaction queue is full
+ * 				 FAILED_OPERATION     : Transaction or it's Device is NULL , it's Length equals zero or SPI_TRANSACTION_QUEUE is disabled
+ * PARAMETERS  : Transaction is a pointer to the transaction descriptor , it's copied to the queue so it can be reused right after the call
+ * DESCRIPTION : This function is used to queue a transaction , the queued transactions are executed in order by the SPI ISR and the next
+ * 				 transaction starts right after the previous one finishes without returning to the main loop
+ * CAUTION     : the TX_Data and RX_Data arrays MUST stay valid till the transaction is finished and the global interrupt MUST be enabled
+ */
+u8 SPI_QueueTransaction(const SPI_Transaction_t *Transaction);
+
+
 /**
  * RETURN      : u8 variable that will contain the SPI_TX_Buffer status it will have one of these values
  * 				 FAILED_OPERATION     : will be the return value if the function was called while the node wasn't configured as slave
@@ -82,4 +217,43 @@ u8 SPI_SlaveSendAndReceiveByte( const u8 *SendData , u8 DropReceivedPacket);
 u8 SPI_SlaveReadByteFromRXBuffer(u8 *ReceiveData);
 
 
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : Registers is a pointer to the user's register array
+ * 				 Size is the number of registers "1 to 256 as the address is a single byte"
+ * 				 WritableSize is the number of the writable registers at the start of the array , the registers at the address WritableSize
+ * 				 and above are read only "ex. Size for all writable , ZERO for all read only"
+ * DESCRIPTION : This function is used in the register map mode to attach the user's register array to the protocol engine
+ * 				 the reads beyond the last register return SPI_REGMAP_FILL_BYTE and the writes to the read only registers are ignored
+ */
+void SPI_SlaveRegMapInit(volatile u8 *Registers, u16 Size, u16 WritableSize);
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : This function is used in the register map mode to end the current transaction , it MUST be called on each SS rising edge
+ * 				 "ex. from an external interrupt ISR" so the next byte from the master is decoded as a command byte
+ */
+void SPI_SlaveRegMapEndOfTransaction(void);
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : Write_UserFunction is a pointer to the user's function , it receives the address of the first written register
+ * 				 and the number of written registers
+ * DESCRIPTION : This function is used to mount the user's function to be executed by SPI_SlaveRegMapEndOfTransaction() at the end
+ * 				 of each write transaction that changed at least one register
+ */
+void SPI_SlaveRegMapExecuteOnWrite(void (*Write_UserFunction)(u8 StartAddress, u16 Count));
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : This function is used to unmount the user's function that is executed at the end of each write transaction
+ */
+void SPI_SlaveRegMap_UserFnDisable(void);
+
+
 #endif /* SPI_INTERFACE_H_ */
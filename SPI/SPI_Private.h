@@ -33,6 +33,39 @@
 
 
 
+//the receive/drop flag of each byte to be shifted out by the slave is stored in a bitmap , one flag per SPI_TX_Buffer location
+//plus one for the byte that is already loaded in SPDR
+#define SKIP_FLAG_SLOTS       (SPI_TX_BUFFER_SIZE+1)
+#define SKIP_FLAG_MAP_SIZE    ((SKIP_FLAG_SLOTS+7)/8)
+//the slave buffers are SPSC_Buffers with free running 8bit indices so their sizes must be powers of two
+#if (SPI_TX_BUFFER_SIZE < 2) || (SPI_TX_BUFFER_SIZE > 128) || ((SPI_TX_BUFFER_SIZE & (SPI_TX_BUFFER_SIZE-1)) != 0) || \
+    (SPI_RX_BUFFER_SIZE < 2) || (SPI_RX_BUFFER_SIZE > 128) || ((SPI_RX_BUFFER_SIZE & (SPI_RX_BUFFER_SIZE-1)) != 0)
+#error "SPI_TX_BUFFER_SIZE and SPI_RX_BUFFER_SIZE MUST be power of two values between 2 and 128"
+#endif
+
+//the states of the slave register map protocol engine
+#define REGMAP_STATE_COMMAND   ((u8)0) //waiting for the command byte
+#define REGMAP_STATE_ADDRESS   ((u8)1) //waiting for the register address byte
+#define REGMAP_STATE_READ      ((u8)2) //streaming the register values to the master
+#define REGMAP_STATE_WRITE     ((u8)3) //storing the master bytes in the registers
+#define REGMAP_STATE_IGNORE    ((u8)4) //unknown command , the rest of the transaction is ignored
+#if SPI_SLAVE_REGISTER_MAP == ENABLE && SPI_OPERATION_MODE != SLAVE_NODE
+#error "SPI_SLAVE_REGISTER_MAP requires SPI_OPERATION_MODE to be SLAVE_NODE"
+#endif
+
+//this macro should be used as return value if a new asynchronous transfer is requested while the previous one hasn't been finished yet
+#define SPI_TRANSFER_BUSY  ((u8)0x18)
+
+#if SPI_TRANSACTION_QUEUE == ENABLE
+  #if SPI_OPERATION_MODE != MASTER_NODE || SPI_MASTER_ASYNC_TRANSFER != ENABLE
+  #error "SPI_TRANSACTION_QUEUE requires a MASTER_NODE with SPI_MASTER_ASYNC_TRANSFER enabled"
+  #endif
+  #if (SPI_TRANSACTION_QUEUE_SIZE < 2) || (SPI_TRANSACTION_QUEUE_SIZE > 128) || ((SPI_TRANSACTION_QUEUE_SIZE & (SPI_TRANSACTION_QUEUE_SIZE-1)) != 0)
+  #error "SPI_TRANSACTION_QUEUE_SIZE MUST be a power of two value between 2 and 128"
+  #endif
+  #define TRANSACTION_QUEUE_MASK  ((u8)(SPI_TRANSACTION_QUEUE_SIZE-1))
+#endif
+
 //this macro should be used as return value if the function execution failed
 #ifndef FAILED_OPERATION
 #define FAILED_OPERATION   ((u8)0x00)
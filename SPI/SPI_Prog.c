@@ -13,29 +13,59 @@
 #include "SPI_Interface.h"
 #include "CircularBufferInterface.h"
 
-#if SPI_OPERATION_MODE == SLAVE_NODE
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == DISABLE
 	//the following flag in used to avoid writing on SPDR register while the previous frame hasn't been shifted out yet
 	u8 volatile static DataCollisionAvoidanceFlag =TRUE;
 
 
-	static CircularBuffer SPI_RX_Buffer; //define a buffer for the RX data
-	static CircularBuffer SPI_TX_Buffer; //define a buffer for the TX data
-
-	//define a variable with suitable size to use it's individual bits as a flag for the packets stored in the TX_Buffer
-	//the flag will determine either to receive or drop the received packet from the master that corresponds to the shifted out packets
-	#if   TX_RX_BUFFER_SIZE <= 8
-	volatile static u8  RX_PacketSkipFlag=0;
-  	#elif TX_RX_BUFFER_SIZE >8 && TX_RX_BUFFER_SIZE <=16
-    volatile static u16 RX_PacketSkipFlag=0;
- 	#elif TX_RX_BUFFER_SIZE >16 && TX_RX_BUFFER_SIZE <=32
-    volatile static u32 RX_PacketSkipFlag=0;
-  	#elif TX_RX_BUFFER_SIZE >32 && TX_RX_BUFFER_SIZE <=64
-    volatile static u64 RX_PacketSkipFlag=0;
-  	#endif
-
-    //the DataSkipIndexer variable will be used to tell how many bytes stored in the salve's SPI_TX_Buffer
-    //will be used to define how many bits used so far from the RX_PacketSkipFlag variable
-    volatile static u8  DataSkipIndexer=0;
+	static SPSC_Buffer SPI_RX_Buffer; //define a buffer for the RX data "the ISR is it's only producer"
+	static SPSC_Buffer SPI_TX_Buffer; //define a buffer for the TX data "the ISR is it's only consumer"
+	static volatile BuffData_t SPI_RX_Storage[SPI_RX_BUFFER_SIZE]; //storage array of the SPI_RX_Buffer
+	static volatile BuffData_t SPI_TX_Storage[SPI_TX_BUFFER_SIZE]; //storage array of the SPI_TX_Buffer
+
+	//the receive/drop flags of the bytes to be shifted out are stored as a bitmap in the same order as the bytes are sent
+	//so the ISR reads a single bit per transfer "constant time regardless of the buffer size"
+	//SkipFlagHead is written by SPI_SlaveSendAndReceiveByte() only and SkipFlagTail is written by the ISR only
+	static volatile u8 RX_PacketSkipMap[SKIP_FLAG_MAP_SIZE];
+	static CBuffSize_t SkipFlagHead=0;              //index of the flag of the next byte to be sent
+	volatile static CBuffSize_t SkipFlagTail=0;    //index of the flag of the byte that is being shifted out
+	volatile static CBuffSize_t SkipFlagCount=0;   //number of the bytes that have a flag but haven't been shifted out yet
+#elif SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == ENABLE
+	//the state of the register map protocol engine , it's written by the ISR and reset by SPI_SlaveRegMapEndOfTransaction()
+	static volatile u8 *RegMap_Registers=NULL; //the user's register array
+	static u16 RegMap_Size=0;                  //number of registers "ZERO till SPI_SlaveRegMapInit() is called"
+	static u16 RegMap_WritableSize=0;          //number of the writable registers at the start of the array
+	volatile static u8  RegMap_State=REGMAP_STATE_COMMAND;
+	volatile static u8  RegMap_Command=0;      //the command byte of the current transaction
+	volatile static u16 RegMap_Address=0;      //the address of the next register to be read or written "u16 so it doesn't wrap after 255"
+	volatile static u8  RegMap_WriteStart=0;   //the address of the first register written by the current transaction
+	volatile static u16 RegMap_WriteCount=0;   //number of the registers written by the current transaction
+	static void (*RegMap_WriteFunc)(u8 StartAddress, u16 Count)=NULL; //pointer to the user's function to be executed at the end of each write
+#elif SPI_OPERATION_MODE == MASTER_NODE && SPI_MASTER_ASYNC_TRANSFER == ENABLE
+	//the state of the asynchronous transfer , it's shared between SPI_MasterTransferAsync() and the transfer complete ISR
+	//so all of it is volatile "the pointers themselves" , the stores can't be kept in registers or moved past the SPDR write that starts the ISR
+	static const u8 * volatile Master_TX_Ptr=NULL; //points at the next byte to be sent "NULL sends the DUMMY_PACKET"
+	static u8 * volatile Master_RX_Ptr=NULL;       //points at where the next received byte will be stored "NULL discards the received bytes"
+	volatile static u16 Master_BytesRemaining=0; //number of bytes that haven't been received yet
+	volatile static u8  Master_TransferActive=FALSE; //set to TRUE while the transfer is in progress "u8 flag to avoid reading the u16 counter non atomically"
+	static void (* volatile Master_TransferCompleteFunc)(void)=NULL; //pointer to the user's function that shall be executed when the transfer is finished
+	volatile static u8 Master_CS_Port=1; //the chip select pin of the current transfer "PB4 for SPI_MasterTransferAsync()"
+	volatile static u8 Master_CS_Pin=4;
+  #if SPI_TRANSACTION_QUEUE == ENABLE
+	//the transaction queue is written by SPI_QueueTransaction() "TransactionQueueHead" and read by the ISR "TransactionQueueTail"
+	static volatile SPI_Transaction_t TransactionQueue[SPI_TRANSACTION_QUEUE_SIZE];
+	volatile static u8 TransactionQueueHead=0;
+	volatile static u8 TransactionQueueTail=0;
+	static const SPI_Device_t * volatile CurrentDevice=NULL; //the device whose settings are loaded in SPCR and SPSR "NULL for the SPI_Init() settings"
+	static u8 Default_SPCR_Value=0; //the SPI_Init() settings used by the SS pin PB4 functions
+	static u8 Default_SPSR_Value=0;
+  #endif
+
+	static void SPI_MasterStartTransfer(void);
+  #if SPI_TRANSACTION_QUEUE == ENABLE
+	static void SPI_StartNextTransaction(void);
+	static void SPI_SelectDefaultSettings(void);
+  #endif
 #endif
 
 
@@ -106,14 +136,25 @@ void SPI_Init(void)
 		  SetRegisterBit(SPCR,CPHA);    //Set  CPHA bit
        #endif
 
+       #if SPI_TRANSACTION_QUEUE == ENABLE
+		  //keep the configured settings so they can be restored after the queued transactions switched to other devices
+		  Default_SPCR_Value=SPCR;
+		  Default_SPSR_Value=SPSR & (1<<SPI2X);
+		  CurrentDevice=NULL;
+       #endif
+
 
   #elif SPI_OPERATION_MODE ==SLAVE_NODE //node configured as slave
      ClearRegisterBit(SPCR,MSTR); // node will be defined as slave
      SetPinDIR(1, 6, 1); //define MISO-BP6 pin as output
      SetRegisterBit(SPCR,SPIE); //SPI interrupt enable
      SetRegisterBit(SREG, 7);   //enable global interrupt
-	 CBuffer_BufferInit(& SPI_TX_Buffer); //initiate the SPI_TX_Buffer
-	 CBuffer_BufferInit(& SPI_RX_Buffer); //initiate the SPI_RX_Buffer
+    #if SPI_SLAVE_REGISTER_MAP == DISABLE
+	 SPSC_BufferInit(&SPI_TX_Buffer, SPI_TX_Storage, SPI_TX_BUFFER_SIZE); //initiate the SPI_TX_Buffer
+	 SPSC_BufferInit(&SPI_RX_Buffer, SPI_RX_Storage, SPI_RX_BUFFER_SIZE); //initiate the SPI_RX_Buffer
+    #else
+	 SPI_SlaveRegMapEndOfTransaction(); //wait for the command byte of the first transaction
+    #endif
   #endif
 }
 
@@ -127,6 +168,9 @@ void SPI_Init(void)
  */
 u8 SPI_MasterSendAndReceiveByte( u8 SendData)
 {
+  #if SPI_TRANSACTION_QUEUE == ENABLE
+	SPI_SelectDefaultSettings(); //the SS pin PB4 transfers use the SPI_Init() settings
+  #endif
 	SetPinValue(1, 4, 0); // pull SS pin PB5 to low state
 	SPDR =SendData; //load the SPDR register with data to be sent
 	while(!GetRegisterBit(SPSR,SPIF)); // halt till the data is shifted out from the SPDR register
@@ -135,6 +179,374 @@ u8 SPI_MasterSendAndReceiveByte( u8 SendData)
 }
 
 
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the transfer has been started
+ * 				 SPI_TRANSFER_BUSY    : the previous asynchronous transfer hasn't been finished yet
+ * 				 FAILED_OPERATION     : Length equals zero , the node isn't a master or SPI_MASTER_ASYNC_TRANSFER is disabled
+ * PARAMETERS  : TX_Data is a pointer to the bytes to be sent , if it's NULL the DUMMY_PACKET is sent instead "receive only transfer"
+ * 				 RX_Data is a pointer to where the received bytes will be stored , if it's NULL the received bytes are discarded "transmit only transfer"
+ * 				 Length is the number of bytes to be transferred
+ * 				 TransferComplete_UserFunction is a pointer to a user defined function to be executed "from the ISR" once the last byte has been received
+ * DESCRIPTION : This function is used ONLY when the node is configured as master to transfer a whole buffer without waiting ,
+ * 				 the SS pin is pulled low for the whole transfer and the bytes are shifted one at a time by the SPI transfer complete interrupt
+ */
+u8 SPI_MasterTransferAsync(const u8 *TX_Data, u8 *RX_Data, u16 Length, void (*TransferComplete_UserFunction)(void))
+{
+	u8 TransferStatus=FAILED_OPERATION; //set TransferStatus as a default value
+#if SPI_OPERATION_MODE == MASTER_NODE && SPI_MASTER_ASYNC_TRANSFER == ENABLE
+	u8 SREG_Copy;
+	if(Length>0)
+	{
+		SREG_Copy=SREG;
+		ClearRegisterBit(SREG, 7); //the bus is checked and claimed without being interrupted by the ISR starting a queued transaction
+		if(Master_TransferActive)
+		{
+			TransferStatus=SPI_TRANSFER_BUSY;
+		}
+		else
+		{
+			Master_TX_Ptr=TX_Data;
+			Master_RX_Ptr=RX_Data;
+			Master_BytesRemaining=Length;
+			Master_TransferCompleteFunc=TransferComplete_UserFunction;
+			Master_CS_Port=1; //the SS pin PB4
+			Master_CS_Pin=4;
+          #if SPI_TRANSACTION_QUEUE == ENABLE
+			SPI_SelectDefaultSettings(); //the SS pin PB4 transfers use the SPI_Init() settings
+          #endif
+			SPI_MasterStartTransfer();
+			TransferStatus=SUCCESSFUL_OPERATION;
+		}
+		SREG=SREG_Copy; //restore the global interrupt state
+	}
+#endif
+	return TransferStatus;
+}
+
+
+#if SPI_OPERATION_MODE == MASTER_NODE && SPI_MASTER_ASYNC_TRANSFER == ENABLE
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : static function that is used to start the transfer described by the Master_xxx variables , the CS pin is pulled low
+ * 				 and the first byte is loaded to SPDR , the rest of the bytes are loaded by the ISR
+ * CAUTION     : it MUST be called with the global interrupt disabled "or from the ISR"
+ */
+static void SPI_MasterStartTransfer(void)
+{
+	Master_TransferActive=TRUE;
+	//a SPIF flag left by a previous polled transfer is cleared by reading SPSR then SPDR so it doesn't trigger the ISR early
+	if(GetRegisterBit(SPSR,SPIF))
+	{
+		(void)SPDR;
+	}
+	SetPinValue(Master_CS_Port, Master_CS_Pin, 0); // pull the CS pin to low state for the whole transfer
+	SetRegisterBit(SPCR,SPIE); //SPI interrupt enable
+	if(Master_TX_Ptr!=NULL)
+	{
+		SPDR=*Master_TX_Ptr; //the first byte starts the transfer
+		Master_TX_Ptr++;
+	}
+	else
+	{
+		SPDR=DUMMY_PACKET;
+	}
+}
+#endif
+
+
+#if SPI_TRANSACTION_QUEUE == ENABLE
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : static function that is used to start the oldest queued transaction if the bus is idle ,
+ * 				 the device settings are written to SPCR and SPSR only if it's not the device of the previous transaction
+ * CAUTION     : it MUST be called with the global interrupt disabled "or from the ISR"
+ */
+static void SPI_StartNextTransaction(void)
+{
+	volatile const SPI_Transaction_t *Next;
+	if(Master_TransferActive || TransactionQueueHead==TransactionQueueTail)
+	{
+		return;
+	}
+	Next=&TransactionQueue[TransactionQueueTail & TRANSACTION_QUEUE_MASK];
+	if(Next->Device!=CurrentDevice) //switch the bus settings to the new device
+	{
+		SPCR=Next->Device->SPCR_Value;
+		SPSR=Next->Device->SPSR_Value;
+		CurrentDevice=Next->Device;
+	}
+	Master_TX_Ptr=Next->TX_Data;
+	Master_RX_Ptr=Next->RX_Data;
+	Master_BytesRemaining=Next->Length;
+	Master_TransferCompleteFunc=Next->TransactionComplete_UserFunction;
+	Master_CS_Port=Next->Device->CS_Port;
+	Master_CS_Pin=Next->Device->CS_Pin;
+	TransactionQueueTail++; //the descriptor has been copied so it's slot is free now
+	SPI_MasterStartTransfer();
+}
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : static function that is used by the SS pin PB4 functions to restore the SPI_Init() settings to SPCR and SPSR
+ * 				 in case the last queued transaction has switched the bus to another device
+ * CAUTION     : it MUST NOT be called while a transfer is in progress
+ */
+static void SPI_SelectDefaultSettings(void)
+{
+	u8 SREG_Copy=SREG;
+	ClearRegisterBit(SREG, 7); //the settings are switched without being interrupted by the ISR starting a queued transaction
+	if(CurrentDevice!=NULL)
+	{
+		SPCR=Default_SPCR_Value;
+		SPSR=Default_SPSR_Value;
+		CurrentDevice=NULL;
+	}
+	SREG=SREG_Copy; //restore the global interrupt state
+}
+#endif
+
+
+/**
+ * RETURN      : u8 variable that will be TRUE while an asynchronous transfer is in progress or FALSE otherwise
+ * PARAMETERS  : VOID
+ * DESCRIPTION : This function is used to check if the last SPI_MasterTransferAsync() transfer has been finished
+ */
+u8 SPI_MasterTransferBusy(void)
+{
+#if SPI_OPERATION_MODE == MASTER_NODE && SPI_MASTER_ASYNC_TRANSFER == ENABLE
+	return Master_TransferActive;
+#else
+	return FALSE;
+#endif
+}
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : Device is a pointer to the device descriptor to be filled
+ * 				 CS_Port and CS_Pin are the DIO port "0 to 3" and pin number of the device chip select pin
+ * 				 ClockMode is one of the CLK_PHASE_POLARITY_MODE_x Macros
+ * 				 MasterFreq is one of the CPU_FREQ_DIV_BYx Macros
+ * 				 DoubleSpeed is either ENABLE or DISABLE Macros
+ * 				 DataOrder is either TRANSMIT_LSB_FIRST or TRANSMIT_MSB_FIRST Macros
+ * DESCRIPTION : This function is used to describe a device on the SPI bus , the SPCR and SPSR values of the device are computed once
+ * 				 so switching between the devices costs two register writes only
+ */
+void SPI_DeviceInit(SPI_Device_t *Device, u8 CS_Port, u8 CS_Pin, u8 ClockMode, u8 MasterFreq, u8 DoubleSpeed, u8 DataOrder)
+{
+	u8 SPCR_Value=(1<<SPE)|(1<<MSTR);
+	if(DataOrder==TRANSMIT_LSB_FIRST)
+	{
+		SPCR_Value|=(1<<DORD);
+	}
+	//the clock modes are ordered as CPOL:CPHA bits
+	if(ClockMode & 0x02)
+	{
+		SPCR_Value|=(1<<CPOL);
+	}
+	if(ClockMode & 0x01)
+	{
+		SPCR_Value|=(1<<CPHA);
+	}
+	switch(MasterFreq)
+	{
+	case CPU_FREQ_DIV_BY16  : SPCR_Value|=(1<<SPR0);             break;
+	case CPU_FREQ_DIV_BY64  : SPCR_Value|=(1<<SPR1);             break;
+	case CPU_FREQ_DIV_BY128 : SPCR_Value|=(1<<SPR1)|(1<<SPR0);   break;
+	default                 : /*CPU_FREQ_DIV_BY4 , SPR1 and SPR0 are cleared*/ break;
+	}
+	Device->SPCR_Value=SPCR_Value;
+	Device->SPSR_Value=(DoubleSpeed==ENABLE)?(1<<SPI2X):0;
+	Device->CS_Port=CS_Port;
+	Device->CS_Pin=CS_Pin;
+	SetPinDIR(CS_Port, CS_Pin, 1);   //define the CS pin as output
+	SetPinValue(CS_Port, CS_Pin, 1); //the device isn't selected
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the transaction has been queued "or started if the bus was idle"
+ * 				 ERROR_BUFFER_FULL    : the transaction queue is full
+ * 				 FAILED_OPERATION     : Transaction or it's Device is NULL , it's Length equals zero or SPI_TRANSACTION_QUEUE is disabled
+ * PARAMETERS  : Transaction is a pointer to the transaction descriptor , it's copied to the queue so it can be reused right after the call
+ * DESCRIPTION : This function is used to queue a transaction , the queued transactions are executed in order by the SPI ISR
+ */
+u8 SPI_QueueTransaction(const SPI_Transaction_t *Transaction)
+{
+	u8 QueueStatus=FAILED_OPERATION; //set QueueStatus as a default value
+#if SPI_TRANSACTION_QUEUE == ENABLE
+	u8 SREG_Copy;
+	if(Transaction!=NULL && Transaction->Device!=NULL && Transaction->Length>0)
+	{
+		if((u8)(TransactionQueueHead-TransactionQueueTail) >= SPI_TRANSACTION_QUEUE_SIZE)
+		{
+			QueueStatus=ERROR_BUFFER_FULL;
+		}
+		else
+		{
+			TransactionQueue[TransactionQueueHead & TRANSACTION_QUEUE_MASK]=*Transaction;
+			SREG_Copy=SREG;
+			ClearRegisterBit(SREG, 7); //the idle bus is checked and the transaction is started without being interrupted by the ISR
+			TransactionQueueHead++;
+			SPI_StartNextTransaction();
+			SREG=SREG_Copy; //restore the global interrupt state
+			QueueStatus=SUCCESSFUL_OPERATION;
+		}
+	}
+#endif
+	return QueueStatus;
+}
+
+
+#if SPI_OPERATION_MODE == MASTER_NODE
+/**
+ * RETURN      : u8 variable that will contain the status of the burst "SUCCESSFUL_OPERATION , SPI_TRANSFER_BUSY or FAILED_OPERATION"
+ * PARAMETERS  : Length is the number of bytes to be transferred
+ * DESCRIPTION : static function that is used to check if a polled burst can be started
+ */
+static u8 SPI_MasterBurstCheck(u16 Length)
+{
+	if(Length==0)
+	{
+		return FAILED_OPERATION;
+	}
+  #if SPI_MASTER_ASYNC_TRANSFER == ENABLE
+	if(Master_TransferActive)
+	{
+		return SPI_TRANSFER_BUSY; //the SPDR is being used by the asynchronous transfer
+	}
+  #endif
+  #if SPI_TRANSACTION_QUEUE == ENABLE
+	SPI_SelectDefaultSettings(); //the SS pin PB4 transfers use the SPI_Init() settings
+  #endif
+	return SUCCESSFUL_OPERATION;
+}
+#endif
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the bytes have been transferred
+ * 				 SPI_TRANSFER_BUSY    : an asynchronous transfer is in progress so nothing has been transferred
+ * 				 FAILED_OPERATION     : Length equals zero or the node isn't a master
+ * PARAMETERS  : TX_Data is a pointer to the bytes to be sent
+ * 				 RX_Data is a pointer to where the received bytes will be stored "it can be the same array as TX_Data"
+ * 				 Length is the number of bytes to be transferred
+ * DESCRIPTION : This function is used ONLY when the node is configured as master to transfer a whole buffer by a tight polling loop
+ * 				 the next byte is fetched while the current one is being shifted , so SPDR is reloaded right after SPIF is set and the
+ * 				 received byte is read after the next transfer has been started "the SPI receive buffer holds it for a whole byte time"
+ * 				 CYCLE COUNT of one loop iteration "static count of the expected avr-gcc -Os code , not measured on the target" :
+ * 				   ld   NextByte,Z+     2 cycles  //fetch the next byte while the current one is being shifted
+ * 				   sbis SPSR,SPIF       1 cycle   //2 cycles once SPIF is set "skips the rjmp"
+ * 				   rjmp .-4             2 cycles  //the polling period is 3 cycles
+ * 				   out  SPDR,NextByte   1 cycle   //the next byte starts being shifted
+ * 				   in   Temp,SPDR       1 cycle
+ * 				   st   X+,Temp         2 cycles
+ * 				   sbiw Length,1        2 cycles
+ * 				   brne loop            2 cycles  //9 cycles of work after the SPDR write , hidden in the byte time
+ * 				 at CPU_FREQ_DIV_BY4 with the double speed mode a byte takes 16 cycles and SPDR is written 3 to 6 cycles after SPIF
+ * 				 is set "2 cycles skip + 1 cycle out + 0 to 3 cycles of the polling period" so each byte takes 19 to 22 cycles
+ * 				 ex. CPU_FREQ = 12MHz : SCK limit = 12MHz/16 = 750000 bytes/s , achieved = 545000 to 632000 bytes/s "73% to 84%"
+ * 				 SPI_MasterBurstWrite() and SPI_MasterBurstRead() have the same SPIF to SPDR path so they reach the same rate
+ */
+u8 SPI_MasterBurst(const u8 *TX_Data, u8 *RX_Data, u16 Length)
+{
+	u8 BurstStatus=FAILED_OPERATION; //set BurstStatus as a default value
+#if SPI_OPERATION_MODE == MASTER_NODE
+	u8 NextByte;
+	BurstStatus=SPI_MasterBurstCheck(Length);
+	if(BurstStatus==SUCCESSFUL_OPERATION)
+	{
+		SetPinValue(1, 4, 0); // pull SS pin PB4 to low state for the whole burst
+		SPDR=*TX_Data++;
+		while(--Length)
+		{
+			NextByte=*TX_Data++; //fetched while the current byte is being shifted
+			while(!GetRegisterBit(SPSR,SPIF)); //halt till the current byte is shifted
+			SPDR=NextByte;       //start the next byte first
+			*RX_Data++=SPDR;     //then read the previous received byte
+		}
+		while(!GetRegisterBit(SPSR,SPIF));
+		*RX_Data=SPDR;
+		SetPinValue(1, 4, 1); //pull SS pin PB4 to high state
+	}
+#endif
+	return BurstStatus;
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the bytes have been transferred
+ * 				 SPI_TRANSFER_BUSY    : an asynchronous transfer is in progress so nothing has been transferred
+ * 				 FAILED_OPERATION     : Length equals zero or the node isn't a master
+ * PARAMETERS  : TX_Data is a pointer to the bytes to be sent , Length is the number of bytes to be sent
+ * DESCRIPTION : This function is the transmit only version of SPI_MasterBurst() , the received bytes are discarded
+ * 				 "writing SPDR after reading SPIF set clears the flag so SPDR doesn't have to be read"
+ */
+u8 SPI_MasterBurstWrite(const u8 *TX_Data, u16 Length)
+{
+	u8 BurstStatus=FAILED_OPERATION; //set BurstStatus as a default value
+#if SPI_OPERATION_MODE == MASTER_NODE
+	u8 NextByte;
+	BurstStatus=SPI_MasterBurstCheck(Length);
+	if(BurstStatus==SUCCESSFUL_OPERATION)
+	{
+		SetPinValue(1, 4, 0); // pull SS pin PB4 to low state for the whole burst
+		SPDR=*TX_Data++;
+		while(--Length)
+		{
+			NextByte=*TX_Data++; //fetched while the current byte is being shifted
+			while(!GetRegisterBit(SPSR,SPIF)); //halt till the current byte is shifted
+			SPDR=NextByte;
+		}
+		while(!GetRegisterBit(SPSR,SPIF));
+		(void)SPDR; //clear the SPIF flag of the last byte
+		SetPinValue(1, 4, 1); //pull SS pin PB4 to high state
+	}
+#endif
+	return BurstStatus;
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ * 				 SUCCESSFUL_OPERATION : the bytes have been transferred
+ * 				 SPI_TRANSFER_BUSY    : an asynchronous transfer is in progress so nothing has been transferred
+ * 				 FAILED_OPERATION     : Length equals zero or the node isn't a master
+ * PARAMETERS  : RX_Data is a pointer to where the received bytes will be stored , Length is the number of bytes to be received
+ * DESCRIPTION : This function is the receive only version of SPI_MasterBurst() , the DUMMY_PACKET is sent for each received byte
+ */
+u8 SPI_MasterBurstRead(u8 *RX_Data, u16 Length)
+{
+	u8 BurstStatus=FAILED_OPERATION; //set BurstStatus as a default value
+#if SPI_OPERATION_MODE == MASTER_NODE
+	BurstStatus=SPI_MasterBurstCheck(Length);
+	if(BurstStatus==SUCCESSFUL_OPERATION)
+	{
+		SetPinValue(1, 4, 0); // pull SS pin PB4 to low state for the whole burst
+		SPDR=DUMMY_PACKET;
+		while(--Length)
+		{
+			while(!GetRegisterBit(SPSR,SPIF)); //halt till the current byte is shifted
+			SPDR=DUMMY_PACKET; //start the next byte first
+			*RX_Data++=SPDR;   //then read the previous received byte
+		}
+		while(!GetRegisterBit(SPSR,SPIF));
+		*RX_Data=SPDR;
+		SetPinValue(1, 4, 1); //pull SS pin PB4 to high state
+	}
+#endif
+	return BurstStatus;
+}
+
+
 /**
  * RETURN      : u8 variable that will contain the SPI_TX_Buffer status it will have one of these values
  * 				 FAILED_OPERATION     : will be the return value if the function was called while the node wasn't configured as slave
@@ -154,24 +566,29 @@ u8 SPI_MasterSendAndReceiveByte( u8 SendData)
 u8 SPI_SlaveSendAndReceiveByte(const u8 *SendData , u8 DropReceivedPacket)
 {
 	u8 TX_BufferStatus=FAILED_OPERATION; //set a TX_BufferStatus as a default value
-#if SPI_OPERATION_MODE == SLAVE_NODE
-	if(!CBuffer_IsTheBufferFull(& SPI_TX_Buffer)) //store flags only if SPI_TX_Buffer isn't full "No of stored flag must equal the SPI_TX_Buffer size"
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == DISABLE
+	u8 SREG_Copy;
+	if(!SPSC_IsTheBufferFull(&SPI_TX_Buffer)) //store flags only if SPI_TX_Buffer isn't full "No of stored flag must equal the SPI_TX_Buffer size"
 	{
 		if(DropReceivedPacket == RX_RECEIVE_PACKET)
 		{
-			//shift 1 to the bit location that corresponds to the current data slot in the SPI_TX_Buffer
-			RX_PacketSkipFlag |=RX_RECEIVE_PACKET<<DataSkipIndexer;
+			//set the flag bit that corresponds to the current data slot
+			RX_PacketSkipMap[SkipFlagHead>>3] |=(u8)(1<<(SkipFlagHead & 0x07));
 		}
 		else
 		{
-			//shift 0 to the bit location that corresponds to the current data slot in the SPI_TX_Buffer
-			RX_PacketSkipFlag &=~(RX_RECEIVE_PACKET<<DataSkipIndexer);
+			//clear the flag bit that corresponds to the current data slot
+			RX_PacketSkipMap[SkipFlagHead>>3] &=(u8)~(1<<(SkipFlagHead & 0x07));
 		}
-		DataSkipIndexer++; //increase the DataSkipIndexer value to point at the next bit location in the RX_PacketSkipFlag
+		SkipFlagHead=(SkipFlagHead==SKIP_FLAG_SLOTS-1)?0:SkipFlagHead+1; //point at the flag of the next data slot
+		SREG_Copy=SREG;
+		ClearRegisterBit(SREG, 7); //the flags counter is shared with the ISR
+		SkipFlagCount++;
+		SREG=SREG_Copy; //restore the global interrupt state
 	}
 
 	//if the SPI_TX_Buffer is empty and ready ,load the data directly to the SPDR register to be ready to be shifted out when the master initiate the communication
-	if(CBuffer_IsTheBufferEmpty(&SPI_TX_Buffer) && DataCollisionAvoidanceFlag)
+	if(SPSC_IsTheBufferEmpty(&SPI_TX_Buffer) && DataCollisionAvoidanceFlag)
 	{
 		//set DataCollisionAvoidanceFlag value to FALSE to avoid writing the SPDR register while it's content hasn't been shifted out yet
 		//it's value will be set to TRUE when the transmit complete interrupt occurs
@@ -184,7 +601,7 @@ u8 SPI_SlaveSendAndReceiveByte(const u8 *SendData , u8 DropReceivedPacket)
 
 	else //in case the SPDR register isn't ready to receive new data , store the passed data into the SPI_TX_Buffer
 	{
-		if(CBuffer_IsTheBufferFull(& SPI_TX_Buffer)== TRUE)
+		if(SPSC_IsTheBufferFull(&SPI_TX_Buffer)== TRUE)
 		{
 			//set the return value to ERROR_BUFFER_FULL as the SPI_TX_Buffer is full
 			TX_BufferStatus =ERROR_BUFFER_FULL;
@@ -192,7 +609,7 @@ u8 SPI_SlaveSendAndReceiveByte(const u8 *SendData , u8 DropReceivedPacket)
 		else
 		{
 			//store the passed data into the SPI_TX_Buffer
-			CBuffer_PushData(&SPI_TX_Buffer, *SendData);
+			SPSC_PushData(&SPI_TX_Buffer, *SendData);
 			//set the return value to SUCCESSFUL_OPERATION
 			TX_BufferStatus =SUCCESSFUL_OPERATION;
 		}
@@ -216,14 +633,14 @@ u8 SPI_SlaveSendAndReceiveByte(const u8 *SendData , u8 DropReceivedPacket)
 u8 SPI_SlaveReadByteFromRXBuffer(u8 *ReceiveData)
 {
 	u8 RX_BufferStatus=FAILED_OPERATION; //set a RX_BufferStatus as a default value
-#if SPI_OPERATION_MODE == SLAVE_NODE
-	if(CBuffer_IsTheBufferEmpty(&SPI_RX_Buffer))
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == DISABLE
+	if(SPSC_IsTheBufferEmpty(&SPI_RX_Buffer))
 	{
 		RX_BufferStatus=ERROR_BUFFER_EMPTY; //set RX_BufferStatus value to ERROR_BUFFER_EMPTY if the SPI_RX_Buffer is empty
 	}
 	else
 	{
-		CBuffer_PopData(&SPI_RX_Buffer, ReceiveData); //pop one byte of data and store it in the variable whose address is stored in ReceiveData
+		SPSC_PopData(&SPI_RX_Buffer, ReceiveData); //pop one byte of data and store it in the variable whose address is stored in ReceiveData
 		RX_BufferStatus=SUCCESSFUL_OPERATION; //set RX_BufferStatus value to SUCCESSFUL_OPERATION
 	}
 #endif
@@ -234,42 +651,217 @@ u8 SPI_SlaveReadByteFromRXBuffer(u8 *ReceiveData)
 
 
 /**
- * Transmit complete interrupt is used only in case the node is configured as slave
+ * RETURN      : VOID
+ * PARAMETERS  : Registers is a pointer to the user's register array
+ * 				 Size is the number of registers "1 to 256 as the address is a single byte"
+ * 				 WritableSize is the number of the writable registers at the start of the array
+ * DESCRIPTION : This function is used in the register map mode to attach the user's register array to the protocol engine
+ */
+void SPI_SlaveRegMapInit(volatile u8 *Registers, u16 Size, u16 WritableSize)
+{
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == ENABLE
+	u8 SREG_Copy=SREG;
+	ClearRegisterBit(SREG, 7); //the register array is replaced without being interrupted by the ISR
+	RegMap_Registers=Registers;
+	RegMap_Size=(Registers==NULL)?0:((Size>256)?256:Size);
+	RegMap_WritableSize=(WritableSize>RegMap_Size)?RegMap_Size:WritableSize;
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
+}
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : This function is used in the register map mode to end the current transaction , it MUST be called on each SS rising edge
+ * 				 the user's write function is executed if the transaction has written any register
+ */
+void SPI_SlaveRegMapEndOfTransaction(void)
+{
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == ENABLE
+	u8 SREG_Copy=SREG;
+	u8  WriteStart;
+	u16 WriteCount;
+	ClearRegisterBit(SREG, 7); //the engine state is reset without being interrupted by the SPI ISR
+	WriteStart=RegMap_WriteStart;
+	WriteCount=RegMap_WriteCount;
+	RegMap_WriteCount=0;
+	RegMap_State=REGMAP_STATE_COMMAND;
+	SPDR=SPI_REGMAP_FILL_BYTE; //the byte shifted out with the command byte of the next transaction
+	SREG=SREG_Copy; //restore the global interrupt state
+	if(WriteCount && RegMap_WriteFunc!=NULL)
+	{
+		RegMap_WriteFunc(WriteStart, WriteCount); //execute the user's function as some registers have been changed
+	}
+#endif
+}
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : Write_UserFunction is a pointer to the user's function
+ * DESCRIPTION : This function is used to mount the user's function to be executed at the end of each write transaction
+ */
+void SPI_SlaveRegMapExecuteOnWrite(void (*Write_UserFunction)(u8 StartAddress, u16 Count))
+{
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == ENABLE
+	if(Write_UserFunction)
+	{
+		RegMap_WriteFunc=Write_UserFunction; //mount the user's function
+	}
+#endif
+}
+
+
+/**
+ * RETURN      : VOID
+ * PARAMETERS  : VOID
+ * DESCRIPTION : This function is used to unmount the user's function that is executed at the end of each write transaction
+ */
+void SPI_SlaveRegMap_UserFnDisable(void)
+{
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == ENABLE
+	RegMap_WriteFunc=NULL; //unmount the user's function by setting RegMap_WriteFunc to NULL
+#endif
+}
+
+
+/**
+ * In case the node is configured as slave the transmit complete interrupt is used to feed the SPDR from the SPI_TX_Buffer
  */
-#if SPI_OPERATION_MODE == SLAVE_NODE
+#if SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == DISABLE
 void __vector_12 (void) __attribute__ ((signal,used));
 void __vector_12 (void)
 {
 
 	u8 SPDR_Data; //temporary storage to store the received data
-	if(DataSkipIndexer) //if DataSkipIndexer not equals zero means that there is new data to be sent from slave or data stored in the SPI_TX_Buffer hasn't been shifted yet
+	if(SkipFlagCount) //if SkipFlagCount not equals zero means that the shifted out byte has been sent by SPI_SlaveSendAndReceiveByte()
 	{
 		//check either to receive or drop the received packet from the master "ex. the received packet is known to be a dummy packet"
-		if(RX_PacketSkipFlag &0x01) //receive the packet corresponding to the shifted out packet in case the flag bit = RX_RECEIVE_PACKET
+		if(RX_PacketSkipMap[SkipFlagTail>>3] & (1<<(SkipFlagTail & 0x07))) //receive the packet corresponding to the shifted out packet in case the flag bit = RX_RECEIVE_PACKET
 		{
 			SPDR_Data=SPDR; // read the received data from the SPDR register
-			CBuffer_PushData(&SPI_RX_Buffer ,SPDR_Data); // store the received data in the SPI_RX_Buffer
+			SPSC_PushData(&SPI_RX_Buffer ,SPDR_Data); // store the received data in the SPI_RX_Buffer
 		}
 		else //drop the received packet corresponding to the shifted out packet in case the flag bit = RX_DROP_PACKET
 		{
 			//no op
 		}
-		RX_PacketSkipFlag>>=1; //shift the flag variable by 1 bit to indicate to the status of the next packet to be received from the master
-		DataSkipIndexer--; //decrease the DataSkipIndexer to point at the previous bit location in the RX_PacketSkipFlag
+		SkipFlagTail=(SkipFlagTail==SKIP_FLAG_SLOTS-1)?0:SkipFlagTail+1; //point at the flag of the next packet to be received from the master
+		SkipFlagCount--;
 	}
-	else //in case the DataSkipIndexer equals zero means that the slave interrupt produced by a received packet from the master with no new data to be sent from the slave
+	else //in case the SkipFlagCount equals zero means that the slave interrupt produced by a received packet from the master with no new data to be sent from the slave
 	{
 		SPDR_Data=SPDR; //read the received data from the SPDR register
-		CBuffer_PushData(&SPI_RX_Buffer ,SPDR_Data); // store the received data in SPI_RX_Buffer
+		SPSC_PushData(&SPI_RX_Buffer ,SPDR_Data); // store the received data in SPI_RX_Buffer
 	}
 
 	//if there is SPI_TX_Buffer isn't empty then pop 1 byte from the buffer and store it into the SPDR register to be shifted in the upcoming 8 clocks from the master
-	if(!CBuffer_IsTheBufferEmpty(& SPI_TX_Buffer))
+	if(!SPSC_IsTheBufferEmpty(&SPI_TX_Buffer))
 	{
-		CBuffer_PopData(&SPI_TX_Buffer ,&SPDR_Data); //pop data from SPI_TX_Buffer and store it in SPDR_Data
+		SPSC_PopData(&SPI_TX_Buffer ,&SPDR_Data); //pop data from SPI_TX_Buffer and store it in SPDR_Data
 		SPDR = SPDR_Data; // load the data to SPDR register
 	}
 
 	DataCollisionAvoidanceFlag=TRUE; //data shifted out of SPDR register and it's free to receive new data
 }
+
+/**
+ * In case of the slave register map mode the transfer complete interrupt decodes the transaction and loads the next byte to SPDR
+ * right away so it's ready before the master starts the next byte
+ */
+#elif SPI_OPERATION_MODE == SLAVE_NODE && SPI_SLAVE_REGISTER_MAP == ENABLE
+void __vector_12 (void) __attribute__ ((signal,used));
+void __vector_12 (void)
+{
+	u8 SPDR_Data=SPDR; //the byte received from the master
+	u8 NextByte=SPI_REGMAP_FILL_BYTE; //the byte to be shifted out with the next master byte
+	switch(RegMap_State)
+	{
+	case REGMAP_STATE_COMMAND :
+		RegMap_Command=SPDR_Data;
+		RegMap_State=(SPDR_Data==SPI_REGMAP_READ_CMD || SPDR_Data==SPI_REGMAP_WRITE_CMD)?REGMAP_STATE_ADDRESS:REGMAP_STATE_IGNORE;
+		break;
+
+	case REGMAP_STATE_ADDRESS :
+		RegMap_Address=SPDR_Data;
+		if(RegMap_Command==SPI_REGMAP_READ_CMD)
+		{
+			RegMap_State=REGMAP_STATE_READ;
+			if(RegMap_Address<RegMap_Size)
+			{
+				NextByte=RegMap_Registers[RegMap_Address]; //the first register value is shifted out with the next master byte
+				RegMap_Address++;
+			}
+		}
+		else
+		{
+			RegMap_State=REGMAP_STATE_WRITE;
+			RegMap_WriteStart=SPDR_Data;
+		}
+		break;
+
+	case REGMAP_STATE_READ : //the received byte is a dummy byte , load the next register value
+		if(RegMap_Address<RegMap_Size)
+		{
+			NextByte=RegMap_Registers[RegMap_Address];
+			RegMap_Address++;
+		}
+		break;
+
+	case REGMAP_STATE_WRITE :
+		if(RegMap_Address<RegMap_WritableSize)
+		{
+			RegMap_Registers[RegMap_Address]=SPDR_Data;
+			RegMap_Address++;
+			RegMap_WriteCount++;
+		}
+		break;
+
+	default : //REGMAP_STATE_IGNORE
+		break;
+	}
+	SPDR=NextByte;
+}
+
+/**
+ * In case the node is configured as master the transfer complete interrupt drives the asynchronous transfers
+ */
+#elif SPI_OPERATION_MODE == MASTER_NODE && SPI_MASTER_ASYNC_TRANSFER == ENABLE
+void __vector_12 (void) __attribute__ ((signal,used));
+void __vector_12 (void)
+{
+	u8 SPDR_Data=SPDR; //reading SPDR is required even if the received byte is discarded
+	if(Master_RX_Ptr!=NULL)
+	{
+		*Master_RX_Ptr=SPDR_Data;
+		Master_RX_Ptr++;
+	}
+	Master_BytesRemaining--;
+	if(Master_BytesRemaining) //load the next byte as soon as the previous one has been shifted
+	{
+		if(Master_TX_Ptr!=NULL)
+		{
+			SPDR=*Master_TX_Ptr;
+			Master_TX_Ptr++;
+		}
+		else
+		{
+			SPDR=DUMMY_PACKET;
+		}
+	}
+	else //the last byte has been received
+	{
+		ClearRegisterBit(SPCR,SPIE); //SPI interrupt disable so the polled SPI_MasterSendAndReceiveByte() can be used again
+		SetPinValue(Master_CS_Port, Master_CS_Pin, 1); //pull the CS pin to high state
+		Master_TransferActive=FALSE;
+		if(Master_TransferCompleteFunc!=NULL)
+		{
+			Master_TransferCompleteFunc(); //execute the user's function as the transfer has been finished
+		}
+      #if SPI_TRANSACTION_QUEUE == ENABLE
+		SPI_StartNextTransaction(); //the next queued transaction starts right away without returning to the main loop
+      #endif
+	}
+}
 #endif
@@ -407,6 +407,60 @@ void Timer1_ICUGetEventData(f32 *TonTime , f32 *DutyCycle ,u16 *Freq)
 }
 
 
+/**
+ * RETURN    : u8 value that will be 1 if the signal has been measured or 0 if the timeout has elapsed first
+ * PARAMETER : TonTicks is a pointer to U32 variable that will contain the measured TON time in timer1 ticks
+ *           ToffTicks is a pointer to U32 variable that will contain the measured TOFF time in timer1 ticks
+ *           TimeoutMs is the maximum time in milliseconds to wait for the next edge of the signal
+ * DESCRIPTION:this function is the same as Timer1_ICUGetEventData() but it returns the raw ticks "no floating point and no
+ * 16bit frequency limit" and it gives up if no edge is captured for TimeoutMs "ex. there is no signal on ICP1 pin"
+ * the timer1 operating clock "CPU_FREQ/prescaler" is required to convert the ticks to time
+ */
+u8 Timer1_ICUGetEventTicks(u32 *TonTicks, u32 *ToffTicks, u16 TimeoutMs)
+{
+	u32 TimeoutOverflows;
+	u16 OverflowsCount;
+	u8  SREG_Copy;
+	u8  Measured=0;
+	//number of timer1 overflows that fits in TimeoutMs , the overflow counter is reset by the ICU ISR on each captured edge
+	TimeoutOverflows=((((u32)TimeoutMs)*((CPU_FREQ/T1_PrescalerDivisor())/1000))>>16)+1;
+	if(TimeoutOverflows>0xFFFF)
+	{
+		TimeoutOverflows=0xFFFF;
+	}
+	TIFR |=(1<<5); //reset input capture flag to avoid accidental interrupt
+	T1_OVF_Counter=0;
+
+	Timer1_ExecuteOnOverFlow(&T1_OVFcounterFunc); //mount overflows counter function
+    Timer1_Enable(); //enable timer1
+
+	SREG  |=(1<<7); //make sure that the global interrupt is enabled
+	TIMSK |=(1<<5); //enable timer1 input capture event interrupt
+
+	do
+	{
+		SREG_Copy=SREG;
+		SREG &=~(1<<7); //the 16bit overflows counter is shared with the ISRs
+		OverflowsCount=T1_OVF_Counter;
+		Measured=(ICU_TonTicks!=0 && ICU_ToffTicks!=0);
+		SREG=SREG_Copy; //restore the global interrupt state
+	}while(!Measured && OverflowsCount<TimeoutOverflows);
+
+	TIMSK &=~(1<<5); //disable timer1 input capture event interrupt
+	Timer1_Stop();
+	Timer1_OVF_UserFnDisable();
+
+	*TonTicks=ICU_TonTicks;
+	*ToffTicks=ICU_ToffTicks;
+
+	ICU_TonTicks=0; //reset the Ton ticks of the last captured event
+	ICU_ToffTicks=0; //reset the Toff ticks of the last captured event
+	ICU_EdgeFlag=0;  //reset the edge flag to ensure the ICU ISR to be executed according to the required rhythm
+	TCCR1B &=~(1<<6); //set the ICU trigger edge to default value 0
+	return Measured;
+}
+
+
 /**
  * RETURN      : VOID
  * PARAMETER   : VOID
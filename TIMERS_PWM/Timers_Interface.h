@@ -356,6 +356,21 @@ void Timer1_InputCaptureInit(void);
 void Timer1_ICUGetEventData(f32 *TonTime, f32 *DutyCycle, u16 *Freq);
 
 
+/**
+ * RETURN    : u8 value that will be 1 if the signal has been measured or 0 if the timeout has elapsed first
+ * PARAMETER : TonTicks is a pointer to U32 variable that will contain the measured TON time in timer1 ticks
+ *           ToffTicks is a pointer to U32 variable that will contain the measured TOFF time in timer1 ticks
+ *           TimeoutMs is the maximum time in milliseconds to wait for the next edge of the signal
+ * DESCRIPTION:this function is the same as Timer1_ICUGetEventData() but it returns the raw ticks "no floating point and no
+ * 16bit frequency limit" and it gives up if no edge is captured for TimeoutMs "ex. there is no signal on ICP1 pin"
+ * the timer1 operating clock "CPU_FREQ/prescaler" is required to convert the ticks to time
+ *
+ * this function handles the use of Timer1_Enble() and Timer1_Stop() by it's own ,
+ * DON'T USE THESE FUNCTIONS WITH THE ICU FUNCTIONALITY
+ */
+u8 Timer1_ICUGetEventTicks(u32 *TonTicks, u32 *ToffTicks, u16 TimeoutMs);
+
+
 /**
  * RETURN      : VOID
  * PARAMETER   : VOID
@@ -0,0 +1,53 @@
+/*
+ * ModbusRTU_Config.h
+ *
+ *  Created on: 17/10/2026
+ *
+ *  Brief : This file contain the configuration required to control the behavior of the Modbus RTU slave engine this configurations are:
+ *  1- The engine selection
+ *     by setting the value of MODBUS_RTU_SLAVE Macros to ENABLE the Modbus RTU slave engine will be compiled
+ *     the engine uses the UART module as it's transport so the following UART_Config.h settings are REQUIRED
+ *     "a compile time error will be produced otherwise"
+ *        A- FRAME_SIZE = _8_BITS_FRAME
+ *        B- UART_IDLE_LINE_FRAMING = ENABLE with UART_IDLE_GAP_HALF_CHARS >= 7 "t3.5" and UART_INTERCHAR_GAP_HALF_CHARS >= 3 "t1.5"
+ *        C- UART_RUNNING_CRC = ENABLE with UART_CRC_TYPE = UART_CRC16_MODBUS "the request CRC is checked while it's being received"
+ *        D- UART_BLOCK_TRANSMIT = ENABLE "the response is sent straight from the engine ADU buffer"
+ *        E- UART_RX_BUFFER_SIZE >= MODBUS_MAX_ADU_SIZE "the UART buffers hold up to 128 locations"
+ *     for RS-485 buses the UART_RS485_DE_CONTROL should be enabled as well
+ *     NOTE: for baud rates above 19200 the Modbus specification uses fixed 750us and 1750us timeouts , the two gap
+ *     settings can be increased above 7 and 3 to approximate them "they can't be decreased below the t3.5 and t1.5 values"
+ *  2- The slave address
+ *     by setting the value of MODBUS_SLAVE_ADDRESS Macros "1 to 247" , the requests sent to the broadcast address ZERO are executed
+ *     "write functions only" without a response
+ *  3- The maximum ADU size
+ *     by setting the value of MODBUS_MAX_ADU_SIZE Macros "8 to UART_RX_BUFFER_SIZE" the size of the engine request/response buffer is set
+ *     the same buffer is used for the request and it's response , the number of registers of a single request is limited accordingly
+ *  4- The request processing context
+ *     by setting the value of MODBUS_PROCESS_FROM_ISR Macros to ENABLE the requests are processed from the idle timer ISR
+ *     as soon as the t3.5 gap ends "the lowest response latency" , in this case the register handlers are executed from the ISR
+ *     and have to be as short as possible , otherwise the user has to call ModbusRTU_Poll() frequently from the main loop
+ *     CAUTION : in case of the ISR processing the engine is the only user of the UART , the application MUST NOT send frames
+ *     "UART_SendDataFrame() , UART_Write() , UART_SendBlock() ..." or read frames "UART_ReceiveDataFrame() , UART_GetPacket() ,
+ *     UART_ReceiveBlock() ..." as the engine ISR is the TX buffer producer and the RX buffer consumer
+ */
+
+#ifndef MODBUSRTU_CONFIG_H_
+#define MODBUSRTU_CONFIG_H_
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                     ENGINE SELECTION
+ -------------------------------------------------------------------------------------------------------------*/
+#define MODBUS_RTU_SLAVE  DISABLE  //change to ENABLE Macros to compile the Modbus RTU slave engine
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                     SLAVE SETTINGS
+ -------------------------------------------------------------------------------------------------------------*/
+#define MODBUS_SLAVE_ADDRESS     1       //the address of this slave "1 to 247"
+#define MODBUS_MAX_ADU_SIZE      64      //size of the request/response buffer in bytes "8 to UART_RX_BUFFER_SIZE"
+#define MODBUS_PROCESS_FROM_ISR  ENABLE  //change to DISABLE Macros to process the requests from ModbusRTU_Poll() in the main loop
+/**************************************************************************************************************/
+
+
+#endif /* MODBUSRTU_CONFIG_H_ */
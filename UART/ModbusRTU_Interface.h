@@ -0,0 +1,59 @@
+/*
+ * ModbusRTU_Interface.h
+ *
+ *  Created on: 17/10/2026
+ *
+ * Brief: This file will contain the Modbus RTU slave engine interface functions
+ * the engine uses the UART idle line packet framing "t3.5" and running CRC for the transport
+ * and dispatches the register reads and writes to the user's handlers tables
+ */
+
+#ifndef MODBUSRTU_INTERFACE_H_
+#define MODBUSRTU_INTERFACE_H_
+#include "UART_Interface.h"
+#include "ModbusRTU_Config.h"
+#include "ModbusRTU_Private.h"
+
+
+/*
+  ModbusRTU_RegisterHandler_t is used to describe a block of registers that is served by the same handler functions
+  StartAddress : the address of the first register of the block
+  Count        : the number of registers of the block
+  Read         : pointer to the user's function that reads the register at Address and stores it's value where Value points at
+  Write        : pointer to the user's function that writes Value to the register at Address "NULL for read only registers"
+  both functions MUST return MODBUS_EX_NONE or one of the MODBUS_EX_xxx exception codes
+*/
+typedef struct {
+	u16 StartAddress;
+	u16 Count;
+	u8 (*Read)(u16 Address, u16 *Value);
+	u8 (*Write)(u16 Address, u16 Value);
+}ModbusRTU_RegisterHandler_t;
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : HoldingTable is a pointer to the user's array of holding registers handlers "function codes 03 , 06 and 16"
+ *             : HoldingTableSize is the number of elements of HoldingTable
+ *             : InputTable is a pointer to the user's array of input registers handlers "function code 04"
+ *             : InputTableSize is the number of elements of InputTable
+ *               any table can be NULL with ZERO size , the requests to it's registers are answered with an illegal data address exception
+ * DESCRIPTION : This function is used to initiate the Modbus RTU slave engine , UART_init() MUST be called before it
+ *               in case MODBUS_PROCESS_FROM_ISR is ENABLED the engine is mounted on the UART complete packet event
+ * CAUTION     : the tables MUST stay valid as long as the engine is used "ex. global const arrays"
+ */
+void ModbusRTU_Init(const ModbusRTU_RegisterHandler_t *HoldingTable, u8 HoldingTableSize,
+		            const ModbusRTU_RegisterHandler_t *InputTable, u8 InputTableSize);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to process the received requests , each complete request with a valid CRC and no inter-character
+ *               timeout that is addressed to this slave is executed and it's response is sent by UART_SendBlock()
+ *               the function has to be called frequently from the main loop if MODBUS_PROCESS_FROM_ISR is DISABLED
+ */
+void ModbusRTU_Poll(void);
+
+
+#endif /* MODBUSRTU_INTERFACE_H_ */
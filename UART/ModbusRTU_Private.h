@@ -0,0 +1,64 @@
+/*
+ * ModbusRTU_Private.h
+ *
+ *  Created on: 17/10/2026
+ *
+ *  Brief: This file will contain the Modbus RTU private Macros "DON'T CHANGE ANY VALUE EXISTS IN THIS FILE"
+ */
+
+#ifndef MODBUSRTU_PRIVATE_H_
+#define MODBUSRTU_PRIVATE_H_
+
+
+//supported function codes
+#define MODBUS_FC_READ_HOLDING_REGISTERS    ((u8)0x03)
+#define MODBUS_FC_READ_INPUT_REGISTERS      ((u8)0x04)
+#define MODBUS_FC_WRITE_SINGLE_REGISTER     ((u8)0x06)
+#define MODBUS_FC_WRITE_MULTIPLE_REGISTERS  ((u8)0x10)
+
+//exception codes , the register handlers MUST return one of them
+#define MODBUS_EX_NONE                  ((u8)0x00) //the register has been read or written successfully
+#define MODBUS_EX_ILLEGAL_FUNCTION      ((u8)0x01)
+#define MODBUS_EX_ILLEGAL_DATA_ADDRESS  ((u8)0x02)
+#define MODBUS_EX_ILLEGAL_DATA_VALUE    ((u8)0x03)
+#define MODBUS_EX_SLAVE_DEVICE_FAILURE  ((u8)0x04)
+
+//the exception responses have the MSB of the function code set
+#define MODBUS_EXCEPTION_FLAG           ((u8)0x80)
+#define MODBUS_BROADCAST_ADDRESS        ((u8)0x00)
+
+//the shortest valid request "address + function code + 2 bytes + CRC" and the fixed size requests length
+#define MODBUS_MIN_ADU_SIZE             4
+#define MODBUS_FIXED_REQUEST_SIZE       8
+#define MODBUS_WRITE_MULTIPLE_HEADER    7  //address + function code + start address + quantity + byte count
+
+
+#if MODBUS_RTU_SLAVE == ENABLE
+  #if FRAME_SIZE != _8_BITS_FRAME
+  #error "The Modbus RTU slave requires FRAME_SIZE to be _8_BITS_FRAME"
+  #endif
+  #if UART_IDLE_LINE_FRAMING != ENABLE
+  #error "The Modbus RTU slave requires UART_IDLE_LINE_FRAMING to be ENABLED"
+  #endif
+  #if (UART_IDLE_GAP_HALF_CHARS < 7) || (UART_INTERCHAR_GAP_HALF_CHARS < 3)
+  #error "The Modbus RTU slave requires UART_IDLE_GAP_HALF_CHARS >= 7 (t3.5) and UART_INTERCHAR_GAP_HALF_CHARS >= 3 (t1.5)"
+  #endif
+  #if (UART_RUNNING_CRC != ENABLE) || (UART_CRC_TYPE != UART_CRC16_MODBUS)
+  #error "The Modbus RTU slave requires UART_RUNNING_CRC to be ENABLED with UART_CRC_TYPE = UART_CRC16_MODBUS"
+  #endif
+  #if UART_BLOCK_TRANSMIT != ENABLE
+  #error "The Modbus RTU slave requires UART_BLOCK_TRANSMIT to be ENABLED"
+  #endif
+  #if (MODBUS_MAX_ADU_SIZE < MODBUS_FIXED_REQUEST_SIZE) || (MODBUS_MAX_ADU_SIZE > 255)
+  #error "MODBUS_MAX_ADU_SIZE MUST be between 8 and 255"
+  #endif
+  #if UART_RX_BUFFER_SIZE < MODBUS_MAX_ADU_SIZE
+  #error "UART_RX_BUFFER_SIZE MUST NOT be less than MODBUS_MAX_ADU_SIZE"
+  #endif
+  #if (MODBUS_SLAVE_ADDRESS < 1) || (MODBUS_SLAVE_ADDRESS > 247)
+  #error "MODBUS_SLAVE_ADDRESS MUST be between 1 and 247"
+  #endif
+#endif
+
+
+#endif /* MODBUSRTU_PRIVATE_H_ */
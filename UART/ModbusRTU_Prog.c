@@ -0,0 +1,272 @@
+/*
+ *  ModbusRTU_Prog.c
+ *  Created on: 17/10/2026
+ *
+ *  Brief: This file will contain the Modbus RTU slave engine functions definition
+ */
+#include "STD_types.h"
+#include "CircularBufferInterface.h"
+#include "UART_Interface.h"
+#include "ModbusRTU_Interface.h"
+
+
+#if MODBUS_RTU_SLAVE == ENABLE
+static const ModbusRTU_RegisterHandler_t *Modbus_HoldingTable=NULL;
+static u8 Modbus_HoldingTableSize=0;
+static const ModbusRTU_RegisterHandler_t *Modbus_InputTable=NULL;
+static u8 Modbus_InputTableSize=0;
+static UARTData_t Modbus_ADU[MODBUS_MAX_ADU_SIZE]; //the request is processed and it's response is built and sent from the same buffer
+static volatile u8 Modbus_ResponseBusy=FALSE;      //TRUE while Modbus_ADU is being sent by UART_SendBlock()
+
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This static function is mounted as the UART_SendBlock() user function to release the ADU buffer after the response is sent
+ */
+static void ModbusRTU_ResponseSent(void)
+{
+	Modbus_ResponseBusy=FALSE;
+}
+
+
+/**
+ * RETURN      : pointer to the handler that serves Address or NULL if no handler in the Table does
+ * PARAMETERS  : Table is a pointer to the registers handlers table and TableSize is it's number of elements
+ *             : Address is the register address
+ * DESCRIPTION : This static function is used to find the handler of a register by a linear search in the handlers table
+ */
+static const ModbusRTU_RegisterHandler_t* ModbusRTU_FindHandler(const ModbusRTU_RegisterHandler_t *Table, u8 TableSize, u16 Address)
+{
+	u8 Index;
+	for(Index=0;Index<TableSize;Index++)
+	{
+		if((Address>=Table[Index].StartAddress) && ((u16)(Address-Table[Index].StartAddress)<Table[Index].Count))
+		{
+			return &Table[Index];
+		}
+	}
+	return NULL;
+}
+
+
+/**
+ * RETURN      : MODBUS_EX_NONE or the exception code of the first register that failed
+ * PARAMETERS  : Table is a pointer to the registers handlers table and TableSize is it's number of elements
+ *             : StartAddress is the address of the first register and Quantity is the number of registers
+ *             : Destination is a pointer to where the registers values will be stored "big endian , 2 bytes each"
+ * DESCRIPTION : This static function is used to read a range of registers through their handlers
+ */
+static u8 ModbusRTU_ReadRegisters(const ModbusRTU_RegisterHandler_t *Table, u8 TableSize, u16 StartAddress, u16 Quantity, UARTData_t *Destination)
+{
+	const ModbusRTU_RegisterHandler_t *Handler;
+	u16 Value;
+	u8 Exception;
+	for(;Quantity>0;Quantity--,StartAddress++)
+	{
+		Handler=ModbusRTU_FindHandler(Table,TableSize,StartAddress);
+		if((Handler==NULL) || (Handler->Read==NULL))
+		{
+			return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+		}
+		Exception=Handler->Read(StartAddress,&Value);
+		if(Exception!=MODBUS_EX_NONE)
+		{
+			return Exception;
+		}
+		*Destination++=(UARTData_t)(Value>>8);
+		*Destination++=(UARTData_t)(Value&0xFF);
+	}
+	return MODBUS_EX_NONE;
+}
+
+
+/**
+ * RETURN      : MODBUS_EX_NONE or the exception code of the first register that failed
+ * PARAMETERS  : StartAddress is the address of the first holding register and Quantity is the number of registers
+ *             : Source is a pointer to the registers values "big endian , 2 bytes each"
+ * DESCRIPTION : This static function is used to write a range of holding registers through their handlers
+ *               all the registers addresses are checked before any of them is written
+ */
+static u8 ModbusRTU_WriteRegisters(u16 StartAddress, u16 Quantity, const UARTData_t *Source)
+{
+	const ModbusRTU_RegisterHandler_t *Handler;
+	u16 Address;
+	u16 Count;
+	u8 Exception;
+	for(Address=StartAddress,Count=Quantity;Count>0;Count--,Address++)
+	{
+		Handler=ModbusRTU_FindHandler(Modbus_HoldingTable,Modbus_HoldingTableSize,Address);
+		if((Handler==NULL) || (Handler->Write==NULL))
+		{
+			return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+		}
+	}
+	for(Address=StartAddress,Count=Quantity;Count>0;Count--,Address++,Source+=2)
+	{
+		Handler=ModbusRTU_FindHandler(Modbus_HoldingTable,Modbus_HoldingTableSize,Address);
+		Exception=Handler->Write(Address,(u16)((u16)Source[0]<<8)|Source[1]);
+		if(Exception!=MODBUS_EX_NONE)
+		{
+			return Exception;
+		}
+	}
+	return MODBUS_EX_NONE;
+}
+
+
+/**
+ * RETURN      : the length of the response in Modbus_ADU without the CRC
+ * PARAMETERS  : RequestLength is the length of the request in Modbus_ADU without the CRC
+ * DESCRIPTION : This static function is used to execute the request in Modbus_ADU and to build it's normal or exception response in place
+ */
+static u8 ModbusRTU_Execute(u8 RequestLength)
+{
+	u8 FunctionCode=(u8)Modbus_ADU[1];
+	u16 StartAddress=((u16)Modbus_ADU[2]<<8)|Modbus_ADU[3];
+	u16 Quantity=((u16)Modbus_ADU[4]<<8)|Modbus_ADU[5];
+	u8 Exception;
+	u8 ResponseLength=0;
+	switch(FunctionCode)
+	{
+	case MODBUS_FC_READ_HOLDING_REGISTERS :
+	case MODBUS_FC_READ_INPUT_REGISTERS :
+		//the response "address , function code , byte count , registers and CRC" has to fit in the ADU buffer
+		if((RequestLength!=MODBUS_FIXED_REQUEST_SIZE-2) || (Quantity==0) || (Quantity>(MODBUS_MAX_ADU_SIZE-5)/2))
+		{
+			Exception=MODBUS_EX_ILLEGAL_DATA_VALUE;
+		}
+		else if(FunctionCode==MODBUS_FC_READ_HOLDING_REGISTERS)
+		{
+			Exception=ModbusRTU_ReadRegisters(Modbus_HoldingTable,Modbus_HoldingTableSize,StartAddress,Quantity,&Modbus_ADU[3]);
+		}
+		else
+		{
+			Exception=ModbusRTU_ReadRegisters(Modbus_InputTable,Modbus_InputTableSize,StartAddress,Quantity,&Modbus_ADU[3]);
+		}
+		Modbus_ADU[2]=(UARTData_t)(Quantity*2);
+		ResponseLength=(u8)(3+Quantity*2);
+		break;
+
+	case MODBUS_FC_WRITE_SINGLE_REGISTER :
+		//the response is an echo of the request
+		if(RequestLength!=MODBUS_FIXED_REQUEST_SIZE-2)
+		{
+			Exception=MODBUS_EX_ILLEGAL_DATA_VALUE;
+		}
+		else
+		{
+			Exception=ModbusRTU_WriteRegisters(StartAddress,1,&Modbus_ADU[4]);
+		}
+		ResponseLength=MODBUS_FIXED_REQUEST_SIZE-2;
+		break;
+
+	case MODBUS_FC_WRITE_MULTIPLE_REGISTERS :
+		//the response is the address , function code , start address and quantity of the request
+		if((RequestLength<MODBUS_WRITE_MULTIPLE_HEADER) || (Quantity==0) || (Quantity>123) ||
+		   (Modbus_ADU[6]!=Quantity*2) || (RequestLength!=MODBUS_WRITE_MULTIPLE_HEADER+Quantity*2))
+		{
+			Exception=MODBUS_EX_ILLEGAL_DATA_VALUE;
+		}
+		else
+		{
+			Exception=ModbusRTU_WriteRegisters(StartAddress,Quantity,&Modbus_ADU[MODBUS_WRITE_MULTIPLE_HEADER]);
+		}
+		ResponseLength=6;
+		break;
+
+	default :
+		Exception=MODBUS_EX_ILLEGAL_FUNCTION;
+		break;
+	}
+	if(Exception!=MODBUS_EX_NONE)
+	{
+		Modbus_ADU[1]=FunctionCode|MODBUS_EXCEPTION_FLAG;
+		Modbus_ADU[2]=Exception;
+		ResponseLength=3;
+	}
+	return ResponseLength;
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : HoldingTable is a pointer to the user's array of holding registers handlers "function codes 03 , 06 and 16"
+ *             : HoldingTableSize is the number of elements of HoldingTable
+ *             : InputTable is a pointer to the user's array of input registers handlers "function code 04"
+ *             : InputTableSize is the number of elements of InputTable
+ *               any table can be NULL with ZERO size , the requests to it's registers are answered with an illegal data address exception
+ * DESCRIPTION : This function is used to initiate the Modbus RTU slave engine , UART_init() MUST be called before it
+ *               in case MODBUS_PROCESS_FROM_ISR is ENABLED the engine is mounted on the UART complete packet event
+ * CAUTION     : the tables MUST stay valid as long as the engine is used "ex. global const arrays"
+ */
+void ModbusRTU_Init(const ModbusRTU_RegisterHandler_t *HoldingTable, u8 HoldingTableSize,
+		            const ModbusRTU_RegisterHandler_t *InputTable, u8 InputTableSize)
+{
+	Modbus_HoldingTable=HoldingTable;
+	Modbus_HoldingTableSize=(HoldingTable==NULL)?0:HoldingTableSize;
+	Modbus_InputTable=InputTable;
+	Modbus_InputTableSize=(InputTable==NULL)?0:InputTableSize;
+	Modbus_ResponseBusy=FALSE;
+    #if MODBUS_PROCESS_FROM_ISR == ENABLE
+	UART_ExecuteOnPacket(ModbusRTU_Poll);
+    #endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to process the received requests , each complete request with a valid CRC and no inter-character
+ *               timeout that is addressed to this slave is executed and it's response is sent by UART_SendBlock()
+ *               the function has to be called frequently from the main loop if MODBUS_PROCESS_FROM_ISR is DISABLED
+ */
+void ModbusRTU_Poll(void)
+{
+	UART_PacketDescriptor_t Request;
+	UART_CRC_t CRC;
+	u8 ErrorValue;
+	u8 Length;
+	while(Modbus_ResponseBusy==FALSE)
+	{
+		if(UART_GetPacket(&Request)!=SUCCESSFUL_OPERATION)
+		{
+			return;
+		}
+		//the packets with dropped frames , a t1.5 gap or a wrong CRC "the residue over a valid frame is ZERO" are silently ignored
+		//and their frames are discarded by the next UART_GetPacket() call
+		if((Request.Status!=0) || (Request.CRC!=0) || (Request.Length<MODBUS_MIN_ADU_SIZE) || (Request.Length>MODBUS_MAX_ADU_SIZE))
+		{
+			continue;
+		}
+		if((UART_ReceiveBlock(Modbus_ADU,Request.Length,&ErrorValue)!=Request.Length) || (ErrorValue!=0))
+		{
+			continue;
+		}
+		if((Modbus_ADU[0]!=MODBUS_SLAVE_ADDRESS) && (Modbus_ADU[0]!=MODBUS_BROADCAST_ADDRESS))
+		{
+			continue;
+		}
+		if((Modbus_ADU[0]==MODBUS_BROADCAST_ADDRESS) && (Modbus_ADU[1]!=MODBUS_FC_WRITE_SINGLE_REGISTER) &&
+		   (Modbus_ADU[1]!=MODBUS_FC_WRITE_MULTIPLE_REGISTERS))
+		{
+			continue;
+		}
+		Length=ModbusRTU_Execute(Request.Length-2);
+		if(Modbus_ADU[0]==MODBUS_BROADCAST_ADDRESS)
+		{
+			continue; //the broadcast requests are never answered
+		}
+		CRC=UART_CRC_Calc((const u8*)Modbus_ADU,Length);
+		Modbus_ADU[Length++]=(UARTData_t)(CRC&0xFF); //the Modbus CRC is sent low byte first
+		Modbus_ADU[Length++]=(UARTData_t)(CRC>>8);
+		Modbus_ResponseBusy=TRUE;
+		if(UART_SendBlock(Modbus_ADU,Length,ModbusRTU_ResponseSent)!=SUCCESSFUL_OPERATION)
+		{
+			Modbus_ResponseBusy=FALSE; //the TX is busy with another block , the request is dropped and the master will retry
+			return;
+		}
+	}
+}
+#endif
@@ -11,12 +11,16 @@
  *  1- The baud rate value
  *     By setting the value of the BAUD_RATE Macros the user can set the desired baud rate , but before that
  *     the user MUST define the CPU operating frequency this can be done by setting the value of CPU_FREQ Macros
+ *     the UBRR value is calculated at compile time "rounded to the nearest value" and a compile time error will be produced
+ *     if the baud rate error exceeds UART_MAX_BAUD_ERROR_PERMILLE "in units of 0.1%"
  *  2- The mode of operation
- *     the user can select between 4 modes represented by the following Macros:
+ *     the user can select between 5 modes represented by the following Macros:
  *        A- NORMAL_ASYNCHRONOUS_UART
  *        B- DOUBLE_SPEED_ASYNCHRONOUS_UART
  *        C- MASTER_SYNCHRONOUS_UART
  *        D- SLAVE_SYNCHRONOUS_UART
+ *        E- AUTO_SPEED_ASYNCHRONOUS_UART "either normal or double speed asynchronous mode will be selected at compile time
+ *           depending on which one gives the lower baud rate error"
  *      the user can select the desired operation mode by setting the value of the OPERATION_MODE macro to one of the previously mentioned Macros
  *  3- Clock Polarity selection in case of Synchronous modes of operation
  *     the user can select on which edge the data sampling will occur
@@ -31,12 +35,23 @@
  *        D- _8_BITS_FRAME "frame size will be 8bits"
  *        E- _9_BITS_FRAME "frame size will be 9bits"
  *  5- TX & RX circular buffer size selection
- *     The user can set the available location for both TX_Buffer and RX_Buffer by setting the value of TX_RX_BUFFER_SIZE Macros
- *     CAUTION: if the frame size is between 5bits to 8bits another circular buffer will be automatically created which is RX_ErrorBuffer
- *     and will have the same No of available locations of the RX_Buffer and will contain the error values for each of the received frames so in this case while
- *     setting the TX_RX_BUFFER_SIZE Macros the user MUST be aware that 3buffers will be created with available locations =TX_RX_BUFFER_SIZE
- *     in case of 5bits to 8bits frames the size of each slot of the TX_Buffer , RX_Buffer and RX_ErrorBuffer will be 2bytes
- *     in case of 9bits frames the size of each slot of the TX_Buffer and RX_Buffer will be 1byte
+ *     The user can set the available location for each of the TX_Buffer and RX_Buffer separately by setting the value of
+ *     UART_TX_BUFFER_SIZE and UART_RX_BUFFER_SIZE Macros "power of two value between 2 and 128 locations each"
+ *     in case of 5bits to 8bits frames the size of each slot of the TX_Buffer and RX_Buffer will be 1byte
+ *     in case of 9bits frames the size of each slot of the TX_Buffer and RX_Buffer will be 2bytes
+ *     RAM footprint : each buffer costs "BufferSize x SlotSize" bytes of storage + 5bytes of control data
+ *     "storage pointer 2bytes + index mask , head and tail indices 1byte each" , the free running 8bit indices are masked to the
+ *     storage locations so the ISR and the application never update a shared counter
+ *     ex. 8bits frames with 128 RX locations and 8 TX locations cost (128+5)+(8+5) = 146bytes + the RX error log
+ *     "4 entries x 2bytes + 2bytes of indices = 10bytes" = 156bytes while the old shared 128 locations buffer size used to cost
+ *     3x(128+5) = 399bytes "RX_Buffer , TX_Buffer and RX_ErrorBuffer"
+ *  5-1- RX error log size selection "5bits to 8bits frames only"
+ *     the PE,DOR and FE errors are not stored for each received frame , only the frames received with errors are recorded
+ *     in a small log "frame index + error value = 2bytes per entry" and the frames received with no errors cost no extra memory
+ *     the user can set the number of log entries by setting the value of UART_RX_ERROR_LOG_SIZE Macros "power of two between 2 and 128"
+ *     if the log is full the error value of the frame is lost "the frame will be read as error free" but it's still counted
+ *     in the receiver statistics that can be read by UART_GetRxStats()
+ *     in case of 9bits frames the error value is stored alongside the data in the RX_Buffer slot and the log isn't created
  *  6- Node functionality selection to either receive or send data or both
  *     This can be achieved by setting the value of NODE_TRANSMIT_DATA and NODE_RECEIVE_DATA Macros to either ENABLE or DISABLE
  *  7- The selection of number of stop bits
@@ -48,6 +63,78 @@
  *     NO_PARITY_CHK "to parity check is used"
  *     ODD_PARITY    "odd parity check is used"
  *     EVEN_PARITY   "even parity check is used"
+ *  9- Block transmit mode selection
+ *     by setting the value of UART_BLOCK_TRANSMIT Macros to ENABLE the UART_SendBlock() function will be available
+ *     in this mode the TX-ISR reads the frames straight from the user's array without copying them into the TX_Buffer
+ *     and a user defined function will be executed once the whole block has been loaded to the UDR register
+ *  10- Idle line packet framing selection
+ *     by setting the value of UART_IDLE_LINE_FRAMING Macros to ENABLE the received frames will be grouped into packets
+ *     a packet ends when no frame is received for UART_IDLE_GAP_HALF_CHARS half character times , then a packet descriptor
+ *     "start index and length" is pushed to a packet queue of UART_PACKET_QUEUE_SIZE entries to be read by UART_GetPacket()
+ *     the idle gap is measured by Timer0 or Timer2 operating in CTC mode "selected by UART_IDLE_TIMER Macros"
+ *     CAUTION: in this mode the TIMERS_PWM module files MUST be added to the project and the selected timer MUST NOT be used by any other application
+ *     the selected timer prescaler in TimersConfig.h MUST be chosen so that half a character time fits in 1 to 255 timer ticks
+ *     "a compile time error will be produced otherwise" , Timer2 MUST use the synchronous clock source
+ *     if UART_INTERCHAR_GAP_HALF_CHARS isn't ZERO the packets that have a longer gap between two of their frames "but shorter than the idle gap"
+ *     are flagged with PACKET_GAP_EXCEEDED in their descriptor status "ex. the t1.5 inter-character timeout of the Modbus RTU"
+ *  11- Automatic baud rate detection selection "asynchronous modes only"
+ *     by setting the value of UART_AUTOBAUD Macros to ENABLE the UART_AutoBaud() function will be available
+ *     the function measures a single sync character 0x55 sent by the host using the Timer1 input capture unit , then the detected
+ *     baud rate is snapped to the nearest standard baud rate "if it's within UART_AUTOBAUD_TOLERANCE_PERMILLE" and loaded by UART_SetBaud()
+ *     the function gives up and returns FAILED_OPERATION if the line stays idle for the timeout passed to it
+ *     CAUTION: in this mode the RXD pin "PD0" MUST be wired to the ICP1 pin "PD6" , the TIMERS_PWM module files MUST be added to the project
+ *     and Timer1 MUST NOT be used by any other application , the TRIGGER_SOURCE in TimersConfig.h MUST be TRIGGER_SRC_ICP1
+ *     and TIMER1_PRESCALER should be as low as possible for the best measurement resolution
+ *  12- Multi-processor communication mode selection "9bits frames only"
+ *     by setting the value of UART_MULTIPROCESSOR_MODE Macros to ENABLE the MPCM bit will be set and the receiver hardware will ignore
+ *     all the data frames "9th bit = 0" until an address frame "9th bit = 1" that matches UART_NODE_ADDRESS or UART_BROADCAST_ADDRESS is received
+ *     the matching address frame is stored in the RX_Buffer followed by the packet data frames , the node drops back to the address listening
+ *     mode when an address frame of another node is received , at the end of each packet in case of the idle line packet framing mode
+ *     or when UART_ListenForAddress() is called
+ *     address frames can be sent by sending the node address ORed with UART_ADDRESS_FRAME Macros
+ *  13- RS-485 driver enable control selection
+ *     by setting the value of UART_RS485_DE_CONTROL Macros to ENABLE the DE/RE pin of the RS-485 transceiver "UART_DE_PORT , UART_DE_PIN"
+ *     is driven to UART_DE_ACTIVE_LEVEL once a transmission starts and released from the TX complete interrupt once the last frame
+ *     has fully left the shift register , so the bus is released as soon as possible without polling the TXC flag
+ *     UART_DE_PORT values are 0 for PORTA , 1 for PORTB , 2 for PORTC and 3 for PORTD
+ *  14- RTS/CTS flow control selection
+ *     by setting the value of UART_FLOW_CONTROL Macros to ENABLE two DIO pins are used as RTS "output" and CTS "input"
+ *     the RTS pin is deasserted by the RX-ISR once the number of unread frames reaches UART_RTS_HIGH_WATERMARK and asserted again
+ *     once the user reads the RX_Buffer down to UART_RTS_LOW_WATERMARK , the space above the high watermark absorbs the frames that
+ *     the remote node sends before it reacts to the RTS pin
+ *     the TX-ISR pauses the transmission while the CTS pin is deasserted , the transmission is resumed by UART_CTS_StateChanged()
+ *     which should be mounted on the external interrupt of the CTS pin "ex. INT0 on PD2 with any logical change trigger" or called periodically
+ *     both pins are active at UART_FLOW_ACTIVE_LEVEL "LOW for the standard RS-232 transceivers"
+ *  15- Delimiter line framing selection
+ *     by setting the value of UART_LINE_FRAMING Macros to ENABLE the RX-ISR closes a line each time UART_LINE_DELIMITER is received
+ *     and pushes it's descriptor to the packet queue "UART_PACKET_QUEUE_SIZE entries" , a whole line can then be read by UART_ReadLine()
+ *     or by UART_GetPacket() followed by UART_ReceiveBlock() , the line includes the delimiter
+ *     this mode can't be used alongside the idle line packet framing mode
+ *  16- Formatted output selection
+ *     by setting the value of UART_PRINTF Macros to ENABLE the UART_Printf() function will be available , it formats the integers , hex values
+ *     fixed-point values , characters and strings straight into the TX_Buffer without a temporary string buffer
+ *  17- Running CRC selection
+ *     by setting the value of UART_RUNNING_CRC Macros to ENABLE the RX-ISR and the TX-ISR update a running CRC with each received
+ *     and transmitted frame "the low 8bits of the frame" using a 16 entries "nibble" lookup table , so the CRC is ready
+ *     the moment the last frame is received or sent , the CRC algorithm is selected by UART_CRC_TYPE Macros
+ *        A- UART_CRC16_MODBUS "poly 0x8005 reflected , init 0xFFFF"
+ *        B- UART_CRC16_CCITT  "poly 0x1021 , init 0xFFFF"
+ *        C- UART_CRC32        "poly 0x04C11DB7 reflected , init and final XOR 0xFFFFFFFF"
+ *     in the packet framing modes the RX CRC is restarted with each packet and it's value is stored in the packet descriptor
+ *  18- COBS packet framing selection "8bits frames only"
+ *     by setting the value of UART_COBS_FRAMING Macros to ENABLE the binary packets are sent by UART_SendPacket() encoded with the
+ *     Consistent Overhead Byte Stuffing "COBS" and ended by a ZERO delimiter , the RX-ISR decodes the received frames one at a time
+ *     "constant work per frame" so the RX_Buffer holds the decoded packet bytes , the complete valid packets are pushed to the packet queue
+ *     and can be read by UART_GetPacket() followed by UART_ReceiveBlock() , the corrupted packets are discarded and the receiver
+ *     resynchronizes on the next ZERO delimiter
+ *     this mode can't be used alongside the idle line or the delimiter line framing modes
+ *  19- Ping-pong RX record mode selection
+ *     by setting the value of UART_PINGPONG_RX Macros to ENABLE the received frames are stored in two record buffers of UART_RECORD_LENGTH
+ *     frames each instead of the RX_Buffer , the RX-ISR fills one half while the application processes the other one then swaps them
+ *     once the record is complete , the complete record is read in place by UART_GetRecord() and returned by UART_ReleaseRecord()
+ *     if the filling half is completed before the other half is released the new record is dropped and the overrun flag is set
+ *     this mode can't be used alongside the packet framing modes or the RTS/CTS flow control "the RX_Buffer isn't used so
+ *     UART_RX_BUFFER_SIZE can be reduced to 2"
  */
 
 #ifndef UART_CONFIG_H_
@@ -57,7 +144,7 @@
  *                                     CPU FREQUENCY
  -------------------------------------------------------------------------------------------------------------*/
 #ifndef CPU_FREQ
-#define CPU_FREQ  ((u32)12000000)  //user has to define the CPU operating frequency
+#define CPU_FREQ 12000000  //user has to define the CPU operating frequency "must match the CPU_FREQ in TimersConfig.h if the TIMERS module is used"
 #endif
 /**************************************************************************************************************/
 
@@ -65,7 +152,8 @@
 /*--------------------------------------------------------------------------------------------------------------
  *                                     BAUD RATE VALUE
  -------------------------------------------------------------------------------------------------------------*/
-#define BAUD_RATE ((u32)9600) //baud rate value
+#define BAUD_RATE 9600UL //baud rate value
+#define UART_MAX_BAUD_ERROR_PERMILLE  20  //maximum allowed baud rate error in units of 0.1% "20 means 2.0%"
 /**************************************************************************************************************/
 
 
@@ -76,6 +164,7 @@
 #define DOUBLE_SPEED_ASYNCHRONOUS_UART   1
 #define        MASTER_SYNCHRONOUS_UART   2
 #define         SLAVE_SYNCHRONOUS_UART   3
+#define   AUTO_SPEED_ASYNCHRONOUS_UART   4
 
 #define UART_OPERATION_MODE   NORMAL_ASYNCHRONOUS_UART
 /**************************************************************************************************************/
@@ -109,9 +198,9 @@
  *                               TX & RX FUNCTIONALITY CONTROL
  *                                TX & RX BUFFER SIZE SETTING
  -------------------------------------------------------------------------------------------------------------*/
-#ifndef TX_RX_BUFFER_SIZE
-#define TX_RX_BUFFER_SIZE  ((u8)10) //TX & RX buffer size control "Number of available locations in buffer"
-#endif
+#define UART_TX_BUFFER_SIZE  16  //TX buffer size control "Number of available locations in buffer , power of two 2 to 128"
+#define UART_RX_BUFFER_SIZE  16  //RX buffer size control "Number of available locations in buffer , power of two 2 to 128"
+#define UART_RX_ERROR_LOG_SIZE  4  //RX error log size control "Number of frames with errors that can be recorded , power of two 2 to 128"
 #define NODE_TRANSMIT_DATA ENABLE   //change to DISABLE Macros to disable the transmitter functionality
 #define NODE_RECEIVE_DATA  ENABLE   //change to DISABLE Macros to disable the receiver functionality
 /**************************************************************************************************************/
@@ -138,6 +227,110 @@
 /**************************************************************************************************************/
 
 
+/*--------------------------------------------------------------------------------------------------------------
+ *                                BLOCK TRANSMIT MODE
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_BLOCK_TRANSMIT  DISABLE  //change to ENABLE Macros to compile the UART_SendBlock() functionality
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                IDLE LINE PACKET FRAMING
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_IDLE_TIMER0   0
+#define UART_IDLE_TIMER2   1
+
+#define UART_IDLE_LINE_FRAMING    DISABLE  //change to ENABLE Macros to group the received frames into packets separated by an idle gap
+#define UART_IDLE_TIMER           UART_IDLE_TIMER0  //the timer that will be used to measure the idle gap
+#define UART_IDLE_GAP_HALF_CHARS  7  //idle gap that ends a packet in half character times "ex. 7 means 3.5 character times"
+#define UART_INTERCHAR_GAP_HALF_CHARS  3  //a longer gap between two frames of a packet flags it PACKET_GAP_EXCEEDED "ex. 3 means 1.5 character times , 0 to disable"
+#define UART_PACKET_QUEUE_SIZE    4  //number of packet "or line" descriptors that can be queued "power of two 2 to 128"
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                DELIMITER LINE FRAMING
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_LINE_FRAMING    DISABLE  //change to ENABLE Macros to group the received frames into lines ended by UART_LINE_DELIMITER
+#define UART_LINE_DELIMITER  '\n'     //the frame value that ends a line
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                   FORMATTED OUTPUT
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_PRINTF  DISABLE  //change to ENABLE Macros to add the UART_Printf() functionality
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                      RUNNING CRC
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_CRC16_MODBUS   0
+#define UART_CRC16_CCITT    1
+#define UART_CRC32          2
+
+#define UART_RUNNING_CRC  DISABLE            //change to ENABLE Macros to update a CRC with each received and transmitted frame
+#define UART_CRC_TYPE     UART_CRC16_MODBUS  //the CRC algorithm
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                  COBS PACKET FRAMING
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_COBS_FRAMING  DISABLE  //change to ENABLE Macros to send and receive COBS encoded packets
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                                  PING-PONG RX RECORDS
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_PINGPONG_RX     DISABLE  //change to ENABLE Macros to receive fixed length records in two alternating buffers
+#define UART_RECORD_LENGTH   16       //number of frames of each record "1 to 255"
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                               AUTOMATIC BAUD RATE DETECTION
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_AUTOBAUD  DISABLE  //change to ENABLE Macros to add the UART_AutoBaud() functionality
+#define UART_AUTOBAUD_TOLERANCE_PERMILLE  50  //max distance between the measured and a standard baud rate to be snapped to it "50 means 5.0%"
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                               MULTI-PROCESSOR COMMUNICATION MODE
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_MULTIPROCESSOR_MODE  DISABLE  //change to ENABLE Macros to filter the received frames by the node address "9bits frames only"
+#define UART_NODE_ADDRESS         0x01     //the address of this node on the bus
+#define UART_BROADCAST_ADDRESS    0xFF     //address frames with this value are accepted by all the nodes
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                               RS-485 DRIVER ENABLE CONTROL
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_RS485_DE_CONTROL  DISABLE  //change to ENABLE Macros to drive the transceiver DE/RE pin around each transmission
+#define UART_DE_PORT           3        //the port of the DE/RE pin "3 means PORTD"
+#define UART_DE_PIN            4        //the pin number of the DE/RE pin
+#define UART_DE_ACTIVE_LEVEL   1        //the pin value that enables the transceiver driver "1 HIGH , 0 LOW"
+/**************************************************************************************************************/
+
+
+/*--------------------------------------------------------------------------------------------------------------
+ *                               RTS/CTS FLOW CONTROL
+ -------------------------------------------------------------------------------------------------------------*/
+#define UART_FLOW_CONTROL        DISABLE  //change to ENABLE Macros to use the RTS/CTS flow control
+#define UART_RTS_PORT            3        //the port of the RTS output pin "3 means PORTD"
+#define UART_RTS_PIN             5        //the pin number of the RTS output pin
+#define UART_CTS_PORT            3        //the port of the CTS input pin "3 means PORTD"
+#define UART_CTS_PIN             2        //the pin number of the CTS input pin "PD2 is the INT0 pin"
+#define UART_FLOW_ACTIVE_LEVEL   0        //the pin value that means ready to receive "1 HIGH , 0 LOW"
+#define UART_RTS_HIGH_WATERMARK  8        //number of unread frames in the RX_Buffer that deasserts the RTS pin
+#define UART_RTS_LOW_WATERMARK   4        //number of unread frames in the RX_Buffer that asserts the RTS pin again
+/**************************************************************************************************************/
+
+
 
 
 #endif /* UART_CONFIG_H_ */
@@ -13,6 +13,42 @@
 #include "UART_private.h"
 
 
+/*
+  UART_RxStats_t is used to take a snapshot of the running receiver statistics
+  FramesReceived is the number of frames that have been received by the RX-ISR "including the dropped frames"
+  FramesDropped  is the number of frames that have been dropped as the RX_Buffer was full
+  LostErrorLogs  is the number of frames that have been received with errors while the RX error log was full
+  HighWaterMark  is the maximum number of unread frames that has been reached in the RX_Buffer
+*/
+typedef struct {
+	u32 FramesReceived;
+	u16 FramesDropped;
+	u16 ParityErrors;
+	u16 OverrunErrors;
+	u16 FrameErrors;
+	u16 LostErrorLogs;
+	u8  HighWaterMark;
+}UART_RxStats_t;
+
+
+/*
+  UART_PacketDescriptor_t is used to describe a complete packet received in the idle line packet framing mode
+  StartIndex : the free running index of the first frame of the packet in the RX_Buffer
+  Length     : the number of frames of the packet that have been stored in the RX_Buffer
+  Status     : ZERO or PACKET_FRAMES_DROPPED if some frames of the packet have been dropped as the RX_Buffer was full
+               and/or PACKET_GAP_EXCEEDED if the packet has an inter-character gap longer than UART_INTERCHAR_GAP_HALF_CHARS "idle line mode"
+  CRC        : the CRC of all the received frames of the packet "only if UART_RUNNING_CRC is ENABLED"
+*/
+typedef struct {
+	u8 StartIndex;
+	u8 Length;
+	u8 Status;
+#if UART_RUNNING_CRC == ENABLE
+	UART_CRC_t CRC;
+#endif
+}UART_PacketDescriptor_t;
+
+
 /**
  * RETURN      : void
  * PARAMETERS  : void
@@ -28,6 +64,7 @@
  *     4- Parity Mode
  *     5- Frame size configuration "5 , 6 , 7, 8 ,9 Bits frame modes"
  *     6- Enable the Transmitter and the receiver and their buffers
+ *     7- Enable the global interrupt "the send functions don't enable it so they can be called from the ISRs callbacks"
  */
 void UART_init(void);
 
@@ -49,6 +86,83 @@ void UART_init(void);
 void UART_SendDataFrame(UARTData_t SendData,u8 *ErrorCode);
 
 
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : the block has been accepted and it's transmission has been started
+ *               UART_TX_BUSY         : a previous block is still being transmitted or the TX_Buffer still has unsent frames
+ *               FAILED_OPERATION     : Block is a NULL pointer , BlockLength equals zero or the block transmit mode is disabled
+ * PARAMETERS  : Block is a pointer to the array of frames to be sent "UARTData_t elements"
+ *             : BlockLength is the number of frames in the Block array
+ *             : BlockSent_UserFunction is a pointer to a user defined function to be executed once the last frame of the block
+ *               has been loaded to the UDR register , it can be NULL if no notification is required
+ * DESCRIPTION : This function is used to send a whole block of frames , the TX-ISR will read the frames straight from the user's array
+ *               without copying them into the TX_Buffer
+ * CAUTION     : the user MUST NOT change the content of the Block array till BlockSent_UserFunction is executed
+ *               any frames sent by UART_SendDataFrame() during the block transmission will be sent after the block
+ */
+u8 UART_SendBlock(const UARTData_t *Block, u16 BlockLength, void (*BlockSent_UserFunction)(void));
+
+
+/**
+ * RETURN      : u16 variable that will contain the number of frames that have been pushed to the TX_Buffer
+ * PARAMETERS  : Source is a pointer to the array of frames to be sent "UARTData_t elements"
+ *             : Count is the number of frames in the Source array
+ * DESCRIPTION : This function is used to push as many frames as the TX_Buffer can hold without waiting , the TX-ISR is started once per call
+ *               the caller can send the rest of the frames "Source + returned value" later ex. after checking UART_TxFree()
+ */
+u16 UART_Write(const UARTData_t *Source, u16 Count);
+
+
+/**
+ * RETURN      : u8 variable that will contain the number of free locations in the TX_Buffer
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to know how many frames can be accepted by UART_Write() or UART_SendDataFrame() right now
+ */
+u8 UART_TxFree(void);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : all the frames have been sent "the last frame has left the shift register"
+ *               FAILED_OPERATION     : the timeout has elapsed before the transmission is finished
+ * PARAMETERS  : TimeoutMs is the maximum waiting time in milliseconds "ZERO checks the transmitter state once without waiting"
+ * DESCRIPTION : This function is used to wait till the TX_Buffer and any active block are sent completely
+ * CAUTION     : the global interrupt MUST be enabled and the function MUST NOT be called from an ISR
+ *               the timeout is counted in CPU_FREQ based polls "no delay functions" , it's the minimum waiting time not an exact one
+ */
+u8 UART_Flush(u16 TimeoutMs);
+
+
+/**
+ * RETURN      : u16 variable that will contain the number of characters that have been pushed to the TX_Buffer
+ * PARAMETERS  : Format is a null terminated string that contains the text to be sent and the following conversion specifiers
+ *               %d %i  : signed integer "s16" , %ld %li for s32
+ *               %u     : unsigned integer "u16" , %lu for u32
+ *               %x %X  : hexadecimal in lower or upper case "u16" , %lx %lX for u32
+ *               %c     : a single character , %s : a null terminated string , %% : the percent sign
+ *               %.Nd   : fixed-point value , the integer is printed with N digits after the decimal point "ex. ("%.2d",-1234) prints -12.34"
+ *               a minimum field width can be set with an optional leading zero for zero padding "ex. %5u , %04X"
+ *             : the rest of the arguments are the values to be printed
+ * DESCRIPTION : This function is used to format the text straight into the TX_Buffer "no temporary string buffer is used"
+ *               the formatting stops once the TX_Buffer is full and the characters pushed so far are still sent
+ *               so the user can compare the return value with the expected length to detect a partial output
+ * CAUTION     : available only if UART_PRINTF is ENABLED , for 5,6,7bits frames the characters are truncated to the frame size
+ */
+u16 UART_Printf(const char *Format, ...);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : the encoded packet has been pushed to the TX_Buffer
+ *               ERROR_BUFFER_FULL    : the TX_Buffer has no room for the whole encoded packet "nothing is pushed"
+ *               FAILED_OPERATION     : Packet is a NULL pointer , Length equals zero or the COBS framing mode is disabled
+ * PARAMETERS  : Packet is a pointer to the array of bytes to be sent and Length is the number of bytes
+ * DESCRIPTION : This function is used in the COBS framing mode to encode the packet straight into the TX_Buffer followed by the ZERO delimiter
+ *               the encoded packet needs Length + 2 locations "+1 for each extra 254 bytes" of the TX_Buffer
+ */
+u8 UART_SendPacket(const u8 *Packet, u8 Length);
+
+
 /**
  * RETURN      : u8 variable that will store the error code related to received frame
  *               return value = ZERO means that the frame received with no errors
@@ -64,6 +178,255 @@ void UART_SendDataFrame(UARTData_t SendData,u8 *ErrorCode);
 u8 UART_ReceiveDataFrame(UARTData_t *ReceivedData);
 
 
+/**
+ * RETURN      : u8 variable that will contain the number of frames that have been copied to ReceivedData
+ * PARAMETERS  : ReceivedData is a pointer to an array of UARTData_t elements where the received frames will be stored
+ *             : Count is the maximum number of frames to be read
+ *             : ErrorValue is a pointer to u8 variable where the combined "ORed" error values of all the read frames will be stored
+ * DESCRIPTION : This function is used to read up to Count frames from the RX_Buffer in a single call
+ */
+u8 UART_ReceiveBlock(UARTData_t *ReceivedData, u8 Count, u8 *ErrorValue);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : a complete packet descriptor has been stored in Packet
+ *               ERROR_BUFFER_EMPTY   : there are no complete packets yet
+ *               FAILED_OPERATION     : both the idle line packet framing and the delimiter line framing modes are disabled
+ * PARAMETERS  : Packet is a pointer to a UART_PacketDescriptor_t variable where the packet descriptor will be stored
+ * DESCRIPTION : This function is used in the idle line packet framing "or delimiter line framing" mode to get the descriptor of the oldest complete packet
+ *               any unread frames that belong to the previous packets are discarded so the next frame in the RX_Buffer is the first frame of the packet
+ *               the packet frames can then be read by calling UART_ReceiveBlock() with Count = Packet->Length
+ */
+u8 UART_GetPacket(UART_PacketDescriptor_t *Packet);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : a complete line has been copied to Line
+ *               UART_LINE_TRUNCATED  : the line was longer than MaxLength , the first MaxLength frames are copied and the rest are discarded
+ *               ERROR_BUFFER_EMPTY   : there are no complete lines yet
+ *               FAILED_OPERATION     : the delimiter line framing mode is disabled
+ * PARAMETERS  : Line is a pointer to an array of UARTData_t elements where the line frames "including the delimiter" will be stored
+ *             : MaxLength is the number of elements of the Line array
+ *             : LineLength is a pointer to u8 variable where the number of copied frames will be stored
+ *             : ErrorValue is a pointer to u8 variable where the combined "ORed" error values of the line frames will be stored
+ *               in addition to PACKET_FRAMES_DROPPED<<4 if some frames of the line have been dropped as the RX_Buffer was full
+ * DESCRIPTION : This function is used in the delimiter line framing mode to read the oldest complete line in a single call
+ */
+u8 UART_ReadLine(UARTData_t *Line, u8 MaxLength, u8 *LineLength, u8 *ErrorValue);
+
+
+/**
+ * RETURN      : pointer to the first frame of the complete record "UART_RECORD_LENGTH frames" or NULL if there is no complete record yet
+ * PARAMETERS  : ErrorValue is a pointer to u8 variable where the combined "ORed" error values of the record frames will be stored
+ * DESCRIPTION : This function is used in the ping-pong RX record mode to get the complete record , the record is read in place
+ *               while the RX-ISR fills the other half
+ * CAUTION     : UART_ReleaseRecord() MUST be called once the record has been processed , the record content isn't valid after it
+ */
+const UARTData_t* UART_GetRecord(u8 *ErrorValue);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used in the ping-pong RX record mode to give the record back to the RX-ISR once it has been processed
+ */
+void UART_ReleaseRecord(void);
+
+
+/**
+ * RETURN      : u8 variable that will be TRUE if any record has been dropped since the last call or FALSE otherwise
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used in the ping-pong RX record mode to read and clear the record overrun flag
+ *               a record is dropped if it's completed before the previous record is released , the dropped frames are also counted in FramesDropped
+ */
+u8 UART_RecordOverrun(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : Stats is a pointer to a UART_RxStats_t variable that has to be defined by the user
+ *               where a copy of the running receiver statistics will be stored
+ * DESCRIPTION : This function is used to read the receiver statistics "received and dropped frames , PARITY , DATA OVER RUN and FRAME errors
+ *               and the RX_Buffer high water mark" since the UART_init() or the last UART_ResetRxStats() call
+ *               the statistics are copied while the global interrupt is disabled so the snapshot is consistent
+ */
+void UART_GetRxStats(UART_RxStats_t *Stats);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to clear the receiver statistics ex. to start a new measurement window
+ */
+void UART_ResetRxStats(void);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : the new baud rate has been loaded to the UBRR registers
+ *               FAILED_OPERATION     : BaudRate can't be achieved with the current CPU_FREQ and operation mode
+ *                                      within UART_MAX_BAUD_ERROR_PERMILLE "the old baud rate is kept"
+ * PARAMETERS  : BaudRate is a u32 value that contains the required baud rate
+ * DESCRIPTION : This function is used to change the baud rate at run time , the UBRR value is calculated and rounded to the nearest value
+ *               in case of AUTO_SPEED_ASYNCHRONOUS_UART mode the U2X bit is selected again depending on which speed gives the lower error
+ *               the TX_Buffer and RX_Buffer contents are kept , any frame still being shifted while the UBRR is changed will be corrupted
+ *               so it's recommended to wait until the transmission is complete before calling this function
+ */
+u8 UART_SetBaud(u32 BaudRate);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used in the multi-processor communication mode to end the current packet and return to the address listening mode
+ *               so all the following data frames are ignored by the receiver hardware until a matching address frame is received
+ *               the function has no effect if UART_MULTIPROCESSOR_MODE is DISABLED
+ */
+void UART_ListenForAddress(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used in the RTS/CTS flow control mode to resume the paused transmission once the CTS pin is asserted again
+ *               it should be mounted on the external interrupt of the CTS pin "ex. Enable_INT0()" or called periodically by the user
+ *               the function has no effect if UART_FLOW_CONTROL is DISABLED
+ */
+void UART_CTS_StateChanged(void);
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : the baud rate has been detected and loaded by UART_SetBaud()
+ *               FAILED_OPERATION     : no sync character has been received within the timeout or the measured baud rate can't be achieved
+ *                                      "the old baud rate is kept"
+ * PARAMETERS  : DetectedBaudRate is a pointer to u32 variable where the detected baud rate will be stored
+ *               TimeoutMs is the maximum waiting time in milliseconds for the next edge of the sync character "the line is idle"
+ * DESCRIPTION : This function is used to detect the host baud rate by measuring a single sync character "0x55" using the Timer1 input capture unit
+ *               the receiver is disabled during the measurement so the sync character isn't stored in the RX_Buffer
+ *               the detected baud rate is snapped to the nearest standard baud rate "1200 to 115200" if it's within UART_AUTOBAUD_TOLERANCE_PERMILLE
+ * CAUTION     : this function is blocking "it waits until the sync character is received or the timeout elapses" , available only if UART_AUTOBAUD is ENABLED
+ */
+u8 UART_AutoBaud(u32 *DetectedBaudRate, u16 TimeoutMs);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : Packet_UserFunction is a pointer to the user's function witch must have a void return and void parameter
+ * DESCRIPTION : This function is used to mount the user's function to be executed each time a complete packet "or line" descriptor
+ *               is pushed to the packet queue , so the packet can be handled without polling UART_GetPacket()
+ * CAUTION     : the user's function is executed from the idle timer ISR or the RX-ISR so it has to be as short as possible
+ */
+void UART_ExecuteOnPacket(void (*Packet_UserFunction)(void));
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function that is executed on each complete packet
+ */
+void UART_Packet_UserFnDisable(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : Record_UserFunction is a pointer to the user's function
+ * DESCRIPTION : This function is used to mount the user's function to be executed "from the RX-ISR" each time a complete record
+ *               is ready in the ping-pong RX record mode , so the record can be handled without polling UART_GetRecord()
+ */
+void UART_ExecuteOnRecord(void (*Record_UserFunction)(void));
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function that is executed on each complete record
+ */
+void UART_Record_UserFnDisable(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : Receive_UserFunction is a pointer to the user's function witch must have a void return and void parameter
+ *             : Threshold is the number of unread frames in the RX_Buffer that triggers the user's function "ZERO is treated as ONE"
+ * DESCRIPTION : This function is used to mount the user's function on the RX complete interrupt , the function is executed after each received frame
+ *               once the RX_Buffer holds at least Threshold unread frames , so the user's function should read the received frames
+ * CAUTION     : the user's function is executed from the RX-ISR so it has to be as short as possible
+ */
+void UART_ExecuteOnReceive(void (*Receive_UserFunction)(void), u8 Threshold);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function from the RX complete interrupt
+ */
+void UART_Receive_UserFnDisable(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : TxEmpty_UserFunction is a pointer to the user's function witch must have a void return and void parameter
+ * DESCRIPTION : This function is used to mount the user's function on the data register empty interrupt , the function is executed
+ *               once the TX_Buffer "and the block being sent" have no more frames to be loaded to UDR , so the user can push the next data
+ * CAUTION     : the user's function is executed from the TX-ISR so it has to be as short as possible
+ */
+void UART_ExecuteOnTxEmpty(void (*TxEmpty_UserFunction)(void));
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function from the data register empty interrupt
+ */
+void UART_TxEmpty_UserFnDisable(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to restart the running RX CRC , it should be called at the start of each packet
+ *               "the RX CRC is restarted automatically with each packet in the packet framing modes"
+ */
+void UART_RxCRC_Reset(void);
+
+
+/**
+ * RETURN      : UART_CRC_t variable "u16 or u32 depending on UART_CRC_TYPE" that will contain the CRC of the frames received since the last reset
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to read the running RX CRC at a packet boundary
+ *               ex. for CRC16 MODBUS the CRC of a packet that ends with it's own CRC "low byte first" equals ZERO if the packet is valid
+ */
+UART_CRC_t UART_RxCRC_Get(void);
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to restart the running TX CRC , it should be called before the first frame of a packet is sent
+ */
+void UART_TxCRC_Reset(void);
+
+
+/**
+ * RETURN      : UART_CRC_t variable that will contain the CRC of the frames loaded to UDR since the last reset
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to read the running TX CRC ex. after UART_SendBlock() user function is executed
+ */
+UART_CRC_t UART_TxCRC_Get(void);
+
+
+/**
+ * RETURN      : UART_CRC_t variable that will contain the CRC of the given array
+ * PARAMETERS  : Data is a pointer to the array of bytes and Length is the number of bytes
+ * DESCRIPTION : This function is used to calculate the CRC of an array with the same algorithm as the running CRC
+ *               ex. to append the CRC to a packet before it's sent "available only if UART_RUNNING_CRC is ENABLED"
+ */
+UART_CRC_t UART_CRC_Calc(const u8 *Data, u16 Length);
+
+
 /**
  * RETURN      : void
  * PARAMETERS  : void
@@ -5,6 +5,7 @@
  *
  *  Brief: This file will contain the UART module functions definition
  */
+#include <stdarg.h>
 #include "STD_types.h"
 #include "Mega32_reg.h"
 #include "REG_utils.h"
@@ -15,14 +16,106 @@
 
 
 #if NODE_RECEIVE_DATA==ENABLE
-static CircularBuffer UART_RX_Buffer; //create a receiver buffer
+static SPSC_Buffer UART_RX_Buffer; //create a receiver buffer "the RX-ISR is it's only producer and the application is it's only consumer"
+static volatile BuffData_t UART_RX_Storage[UART_RX_BUFFER_SIZE]; //storage array of the receiver buffer
   #if FRAME_SIZE != _9_BITS_FRAME
-  static CircularBuffer RX_ErrorBuffer;  //create a buffer to store the error corresponding to each frame
+  //the RX error log will record only the frames that have been received with errors
+  //the RX-ISR is the only writer of RX_ErrorLogHead and the UART_ReceiveDataFrame() is the only writer of RX_ErrorLogTail
+  static volatile RX_ErrorLogEntry_t RX_ErrorLog[UART_RX_ERROR_LOG_SIZE];
+  volatile static u8 RX_ErrorLogHead=0;
+  volatile static u8 RX_ErrorLogTail=0;
+  #endif
+  volatile static u8 RX_PushedFrameIndex=0; //free running index of the next frame to be pushed to the UART_RX_Buffer
+  static u8 RX_PoppedFrameIndex=0;          //free running index of the next frame to be popped from the UART_RX_Buffer
+  #if UART_PACKET_QUEUE == ENABLE
+  //the packet queue is written by the idle timer ISR or the RX-ISR "RX_PacketQueueHead" and read by UART_GetPacket() "RX_PacketQueueTail"
+  static volatile UART_PacketDescriptor_t RX_PacketQueue[UART_PACKET_QUEUE_SIZE];
+  volatile static u8 RX_PacketQueueHead=0;
+  volatile static u8 RX_PacketQueueTail=0;
+  volatile static UART_PacketDescriptor_t RX_OpenPacket; //the packet that is being received
+  volatile static u8 RX_PacketOpen=FALSE;     //set to TRUE once the first frame of a packet is received
+  static void (*RX_PacketFunc)(void)=NULL;   //static pointer to store the address of the user's function to be executed on each complete packet
+  #endif
+  #if UART_IDLE_LINE_FRAMING == ENABLE
+  volatile static u8 RX_IdleHalfChars=0;      //number of half character times passed since the last received frame
+  #endif
+  #if UART_COBS_FRAMING == ENABLE
+  volatile static u8 RX_CobsCodeRemaining=0; //number of data bytes left in the current COBS block "ZERO means the next byte is a code byte"
+  volatile static u8 RX_CobsZeroPending=FALSE; //set to TRUE if the current COBS block ends with an implied ZERO byte
+  #endif
+  #if UART_PINGPONG_RX == ENABLE
+  //the RX-ISR only writes the filling half and the application only reads the ready half , so the records need no volatile access
+  static UARTData_t RX_Records[2][UART_RECORD_LENGTH];
+  volatile static u8 RX_RecordErrors[2];         //combined "ORed" error values of the frames of each half
+  volatile static u8 RX_FillingHalf=0;           //index of the half that is being filled by the RX-ISR
+  volatile static u8 RX_RecordFill=0;            //number of frames stored in the filling half
+  volatile static u8 RX_RecordReady=FALSE;       //set to TRUE by the RX-ISR when the other half holds a complete record
+  volatile static u8 RX_RecordOverrun=FALSE;     //set to TRUE when a record is dropped as the other half hasn't been released
+  static void (*RX_RecordFunc)(void)=NULL;      //static pointer to store the address of the user's function to be executed on each complete record
+  #endif
+  volatile static UART_RxStats_t RX_Stats; //running statistics of the received frames
+  #if UART_FLOW_CONTROL == ENABLE
+  volatile static u8 RX_RTS_Deasserted=FALSE; //set to TRUE by the RX-ISR once the high watermark is reached
+  #endif
+  #if UART_RUNNING_CRC == ENABLE
+  volatile static UART_CRC_t RX_CRC_Register=UART_CRC_INIT; //running CRC of the received frames
+  #endif
+  static void (*RX_ReceiveFunc)(void)=NULL; //static pointer to store the address of the user's function to be executed on receive
+  static u8 RX_ReceiveThreshold=1;          //number of unread frames that triggers the user's function
+#endif
+
+#if NODE_TRANSMIT_DATA==ENABLE
+static SPSC_Buffer UART_TX_Buffer; //create a transmitter buffer "the application is it's only producer and the TX-ISR is it's only consumer"
+static volatile BuffData_t UART_TX_Storage[UART_TX_BUFFER_SIZE]; //storage array of the transmitter buffer
+  #if UART_BLOCK_TRANSMIT == ENABLE
+  static const UARTData_t * volatile TX_BlockPtr=NULL; //points at the next frame to be sent from the user's block "the pointer itself is volatile as it's shared with the TX-ISR"
+  volatile static u16 TX_BlockRemaining=0;   //number of frames of the user's block that hasn't been sent yet
+  volatile static u8  TX_BlockActive=FALSE;  //set to TRUE while a block is being transmitted "u8 flag to avoid reading the u16 counter non atomically"
+  static void (* volatile TX_BlockSentFunc)(void)=NULL; //pointer to the user's function that shall be executed when the block has been sent
+  #endif
+  #if UART_RUNNING_CRC == ENABLE
+  volatile static UART_CRC_t TX_CRC_Register=UART_CRC_INIT; //running CRC of the transmitted frames
+  #endif
+  static void (*TX_EmptyFunc)(void)=NULL; //static pointer to store the address of the user's function to be executed when the UART_TX_Buffer runs empty
+  #if UART_RS485_DE_CONTROL == DISABLE
+  static u8 TX_Started=FALSE; //set to TRUE by the first transmission , till then the TXC flag can't tell that the transmitter is idle
   #endif
 #endif
 
+#if UART_RUNNING_CRC == ENABLE
+//16 entries lookup table of the selected CRC algorithm "one entry per nibble value"
+  #if   UART_CRC_TYPE == UART_CRC16_MODBUS
+static const u16 UART_CRC_Table[16]={0x0000,0xCC01,0xD801,0x1400,0xF001,0x3C00,0x2800,0xE401,
+                                     0xA001,0x6C00,0x7800,0xB401,0x5000,0x9C01,0x8801,0x4400};
+  #elif UART_CRC_TYPE == UART_CRC16_CCITT
+static const u16 UART_CRC_Table[16]={0x0000,0x1021,0x2042,0x3063,0x4084,0x50A5,0x60C6,0x70E7,
+                                     0x8108,0x9129,0xA14A,0xB16B,0xC18C,0xD1AD,0xE1CE,0xF1EF};
+  #elif UART_CRC_TYPE == UART_CRC32
+static const u32 UART_CRC_Table[16]={0x00000000UL,0x1DB71064UL,0x3B6E20C8UL,0x26D930ACUL,0x76DC4190UL,0x6B6B51F4UL,0x4DB26158UL,0x5005713CUL,
+                                     0xEDB88320UL,0xF00F9344UL,0xD6D6A3E8UL,0xCB61B38CUL,0x9B64C2B0UL,0x86D3D2D4UL,0xA00AE278UL,0xBDBDF21CUL};
+  #endif
+static UART_CRC_t UART_CRC_Update(UART_CRC_t CRC, u8 Data);
+#endif
+
+static u16 UART_CalcUBRR(u8 Divisor, u32 BaudRate, u16 *BaudError);
 #if NODE_TRANSMIT_DATA==ENABLE
-static CircularBuffer UART_TX_Buffer; //create a transmitter buffer
+static void UART_TX_Start(void);
+static u8 UART_TX_IsDrained(void);
+#endif
+#if NODE_TRANSMIT_DATA==ENABLE && UART_PRINTF == ENABLE
+static u8 UART_PrintNumber(u32 Value, u8 Negative, u8 Base, u8 UpperCase, u8 Width, u8 ZeroPad, u8 FracDigits, u16 *Written);
+#endif
+#if NODE_RECEIVE_DATA==ENABLE && FRAME_SIZE != _9_BITS_FRAME
+static u8 UART_PopFrameErrorValue(void);
+#endif
+#if NODE_RECEIVE_DATA==ENABLE && UART_PACKET_QUEUE == ENABLE
+static void UART_ClosePacket(void);
+#endif
+#if NODE_RECEIVE_DATA==ENABLE && UART_IDLE_LINE_FRAMING == ENABLE
+static void UART_IdleTimerTick(void);
+#endif
+#if NODE_RECEIVE_DATA==ENABLE && UART_FLOW_CONTROL == ENABLE
+static void UART_RTS_CheckLowWatermark(void);
 #endif
 
 
@@ -46,16 +139,12 @@ void UART_init(void)
 {
   u8 TempUBRRH=0;
   u8 TempUCSRC=0;
-	//baud rate configuration
-   u16 UBRR_Value;
-   #if   UART_OPERATION_MODE == NORMAL_ASYNCHRONOUS_UART //calculate the baud rate in case of Normal Asynchronous mode
-    UBRR_Value=((u16)((CPU_FREQ/(16*BAUD_RATE))-1));
-
-   #elif UART_OPERATION_MODE == DOUBLE_SPEED_ASYNCHRONOUS_UART // calculate the baud rate in case of double speed Asynchronous mode
-    UBRR_Value=((u16)((CPU_FREQ/(8*BAUD_RATE))-1));
-
-   #elif UART_OPERATION_MODE == MASTER_SYNCHRONOUS_UART || UART_OPERATION_MODE == SLAVE_SYNCHRONOUS_UART //calculate the baud rate in case of Synchronous modes
-    UBRR_Value=((u16)((CPU_FREQ/(2*BAUD_RATE))-1));
+	//baud rate configuration , the UBRR value is calculated at compile time "UART_UBRR_VALUE in UART_private.h"
+   u16 UBRR_Value=((u16)UART_UBRR_VALUE);
+   #if   UART_RESOLVED_OPERATION_MODE == DOUBLE_SPEED_ASYNCHRONOUS_UART
+    SetRegisterBit(UCSRA,U2X);   //U2X=1 double the transfer rate
+   #else
+    ClearRegisterBit(UCSRA,U2X); //U2X=0
    #endif
 
     UBRRL =((u8)(UBRR_Value & 0x00FF)); //store the UBRR low byte to achieve the required baud rate in UBRRL register
@@ -69,15 +158,15 @@ void UART_init(void)
 	//UART mode select
     SetRegisterBit(TempUCSRC,URSEL); //select UCSRC register
 
-   #if   UART_OPERATION_MODE == NORMAL_ASYNCHRONOUS_UART
+   #if   UART_RESOLVED_OPERATION_MODE == NORMAL_ASYNCHRONOUS_UART
     ClearRegisterBit(TempUCSRC,UMSEL); //UMSEL=0
     ClearRegisterBit(TempUCSRC,UCPOL); //UCPOL=0
 
-   #elif UART_OPERATION_MODE == DOUBLE_SPEED_ASYNCHRONOUS_UART
+   #elif UART_RESOLVED_OPERATION_MODE == DOUBLE_SPEED_ASYNCHRONOUS_UART
     ClearRegisterBit(TempUCSRC,UMSEL); //UMSEL=0
     ClearRegisterBit(TempUCSRC,UCPOL); //UCPOL=0
 
-   #elif UART_OPERATION_MODE == MASTER_SYNCHRONOUS_UART
+   #elif UART_RESOLVED_OPERATION_MODE == MASTER_SYNCHRONOUS_UART
     SetRegisterBit(TempUCSRC,UMSEL); // UMSEL=1
 	SetPinDIR(1, 0, 1) ;  //define XCK_PB0 as output "Master is the clock source"
 	   // define the sampling clock polarity
@@ -87,7 +176,7 @@ void UART_init(void)
 	       SetRegisterBit(TempUCSRC,UCPOL);  //UCPOL=1
          #endif
 
-   #elif UART_OPERATION_MODE == SLAVE_SYNCHRONOUS_UART
+   #elif UART_RESOLVED_OPERATION_MODE == SLAVE_SYNCHRONOUS_UART
 	SetRegisterBit(TempUCSRC,UMSEL); //UMSEL=1
 	SetPinDIR(1, 0, 0); //define XCK_PB0 as input "Slave is the clock source"
 	   // define the sampling clock polarity
@@ -155,14 +244,53 @@ void UART_init(void)
 
 	//enable transmitter and receiver if enabled and create circular buffer for each
    #if NODE_TRANSMIT_DATA==ENABLE
-	CBuffer_BufferInit(& UART_TX_Buffer); //initiate the transmitter buffer
+	SPSC_BufferInit(&UART_TX_Buffer, UART_TX_Storage, UART_TX_BUFFER_SIZE); //initiate the transmitter buffer
+      #if UART_RS485_DE_CONTROL == ENABLE
+	SetPinValue(UART_DE_PORT, UART_DE_PIN, !UART_DE_ACTIVE_LEVEL); //the driver is disabled till there is something to send
+	SetPinDIR(UART_DE_PORT, UART_DE_PIN, 1);
+      #endif
+      #if UART_FLOW_CONTROL == ENABLE
+	SetPinDIR(UART_CTS_PORT, UART_CTS_PIN, 0); //the CTS pin is an input driven by the remote node
+      #endif
 	SetRegisterBit(UCSRB,TXEN); //Transmitter Enable
+	SetRegisterBit(SREG, 7); //enable global interrupt "the send functions only enable the TX-ISR as they may be called from the ISRs callbacks"
    #endif
 
    #if NODE_RECEIVE_DATA==ENABLE
-	CBuffer_BufferInit(& UART_RX_Buffer); //initiate the receiver buffer
+	SPSC_BufferInit(&UART_RX_Buffer, UART_RX_Storage, UART_RX_BUFFER_SIZE); //initiate the receiver buffer
       #if FRAME_SIZE != _9_BITS_FRAME
-	  CBuffer_BufferInit(&RX_ErrorBuffer); //initiate the receiver's error buffer in case the frame size is less than 9bits
+	  RX_ErrorLogHead=RX_ErrorLogTail=0; //clear the receiver's error log in case the frame size is less than 9bits
+      #endif
+	RX_PushedFrameIndex=RX_PoppedFrameIndex=0;
+      #if UART_PACKET_QUEUE == ENABLE
+	RX_PacketQueueHead=RX_PacketQueueTail=0;
+	RX_PacketOpen=FALSE;
+      #endif
+      #if UART_COBS_FRAMING == ENABLE
+	RX_CobsCodeRemaining=0;
+	RX_CobsZeroPending=FALSE;
+      #endif
+      #if UART_PINGPONG_RX == ENABLE
+	RX_FillingHalf=0;
+	RX_RecordFill=0;
+	RX_RecordErrors[0]=0;
+	RX_RecordReady=FALSE;
+	RX_RecordOverrun=FALSE;
+      #endif
+      #if UART_IDLE_LINE_FRAMING == ENABLE
+	UART_IdleTimerCTCInit(); //the idle timer will produce a compare match every half character time
+	UART_IdleTimerSetComp(UART_IDLE_TIMER_COMP_VALUE);
+	UART_IdleTimerMount(UART_IdleTimerTick);
+	UART_IdleTimerEnable();
+      #endif
+	UART_ResetRxStats();
+      #if UART_MULTIPROCESSOR_MODE == ENABLE
+	UART_SetMPCM(); //start in the address listening mode
+      #endif
+      #if UART_FLOW_CONTROL == ENABLE
+	RX_RTS_Deasserted=FALSE;
+	SetPinValue(UART_RTS_PORT, UART_RTS_PIN, UART_FLOW_ACTIVE_LEVEL); //the RX_Buffer is empty so the remote node can send
+	SetPinDIR(UART_RTS_PORT, UART_RTS_PIN, 1);
       #endif
 	SetRegisterBit(UCSRB,RXEN); //Receiver Enable
 	SetRegisterBit(SREG, 7); //enable global interrupt
@@ -172,6 +300,155 @@ void UART_init(void)
 }
 
 
+/**
+ * RETURN      : u8 variable that will contain SUCCESSFUL_OPERATION or FAILED_OPERATION
+ * PARAMETERS  : BaudRate is a u32 value that contains the required baud rate
+ * DESCRIPTION : This function is used to change the baud rate at run time without re-initiating the TX_Buffer and RX_Buffer
+ */
+u8 UART_SetBaud(u32 BaudRate)
+{
+	u8  OperationStatus=FAILED_OPERATION;
+	u16 UBRR_Value;
+	u16 BaudError;
+  #if UART_OPERATION_MODE == AUTO_SPEED_ASYNCHRONOUS_UART
+	u16 DoubleUBRR_Value;
+	u16 DoubleBaudError;
+	u8  DoubleSpeed=FALSE;
+  #endif
+
+	if(BaudRate != 0)
+	{
+   #if   UART_OPERATION_MODE == NORMAL_ASYNCHRONOUS_UART
+		UBRR_Value=UART_CalcUBRR(16, BaudRate, &BaudError);
+   #elif UART_OPERATION_MODE == DOUBLE_SPEED_ASYNCHRONOUS_UART
+		UBRR_Value=UART_CalcUBRR(8, BaudRate, &BaudError);
+   #elif UART_OPERATION_MODE == AUTO_SPEED_ASYNCHRONOUS_UART
+		UBRR_Value      =UART_CalcUBRR(16, BaudRate, &BaudError);
+		DoubleUBRR_Value=UART_CalcUBRR(8, BaudRate, &DoubleBaudError);
+		if(DoubleBaudError < BaudError) //the normal speed mode is preferred in case of equal errors
+		{
+			UBRR_Value=DoubleUBRR_Value;
+			BaudError =DoubleBaudError;
+			DoubleSpeed=TRUE;
+		}
+   #else
+		UBRR_Value=UART_CalcUBRR(2, BaudRate, &BaudError);
+   #endif
+
+   #if UART_OPERATION_MODE == SLAVE_SYNCHRONOUS_UART
+		BaudError=0; //the slave is clocked by the master , the UBRR value has no effect
+   #endif
+
+		if(BaudError <= UART_MAX_BAUD_ERROR_PERMILLE)
+		{
+   #if UART_OPERATION_MODE == AUTO_SPEED_ASYNCHRONOUS_UART
+			if(DoubleSpeed)
+			{
+				SetRegisterBit(UCSRA,U2X);   //U2X=1 double the transfer rate
+			}
+			else
+			{
+				ClearRegisterBit(UCSRA,U2X); //U2X=0
+			}
+   #endif
+			UBRRH =((u8)((UBRR_Value & 0x0F00)>>8)); //URSEL=0 select UBRRH register , UBRRH must be written first as writing UBRRL updates the prescaler
+			UBRRL =((u8)(UBRR_Value & 0x00FF));
+			OperationStatus=SUCCESSFUL_OPERATION;
+		}
+	}
+	return OperationStatus;
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to return to the address listening mode in the multi-processor communication mode
+ */
+void UART_ListenForAddress(void)
+{
+#if NODE_RECEIVE_DATA==ENABLE && UART_MULTIPROCESSOR_MODE == ENABLE
+	UART_SetMPCM();
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to resume the transmission that has been paused by the CTS pin
+ */
+void UART_CTS_StateChanged(void)
+{
+#if NODE_TRANSMIT_DATA==ENABLE && UART_FLOW_CONTROL == ENABLE
+	u8 TX_Pending=!SPSC_IsTheBufferEmpty(&UART_TX_Buffer);
+  #if UART_BLOCK_TRANSMIT == ENABLE
+	TX_Pending|=TX_BlockActive;
+  #endif
+	if(TX_Pending && GetPinValue(UART_CTS_PORT, UART_CTS_PIN) == UART_FLOW_ACTIVE_LEVEL)
+	{
+		UART_TX_Start();
+	}
+#endif
+}
+
+
+#if UART_AUTOBAUD == ENABLE
+/**
+ * RETURN      : u8 variable that will contain SUCCESSFUL_OPERATION or FAILED_OPERATION
+ * PARAMETERS  : DetectedBaudRate is a pointer to u32 variable where the detected baud rate will be stored
+ *               TimeoutMs is the maximum waiting time in milliseconds for the next edge of the sync character
+ * DESCRIPTION : This function is used to detect the host baud rate from a single sync character "0x55"
+ *               the 0x55 character toggles the line every bit time , the ICU measures the start bit "low" and the first data bit "high"
+ *               so the measured signal period equals two bit times , it's measured in timer1 ticks so the 32bit baud rate doesn't overflow
+ */
+u8 UART_AutoBaud(u32 *DetectedBaudRate, u16 TimeoutMs)
+{
+	static const u32 StandardBaudRates[]={1200,2400,4800,9600,14400,19200,28800,38400,57600,76800,115200};
+	u32 TonTicks;
+	u32 ToffTicks;
+	u32 MeasuredBaud;
+	u32 Difference;
+	u8  Counter;
+	u8  OperationStatus=FAILED_OPERATION;
+  #if NODE_RECEIVE_DATA==ENABLE
+	u8  ReceiverState=UCSRB & ((1<<RXEN)|(1<<RXCIE));
+
+	ClearRegisterBit(UCSRB,RXCIE); //the sync character shouldn't be stored in the RX_Buffer
+	ClearRegisterBit(UCSRB,RXEN);
+  #endif
+
+	Timer1_InputCaptureInit();
+	//blocking until the start bit and the first data bit have been measured or the line stays idle for TimeoutMs
+	if(Timer1_ICUGetEventTicks(&TonTicks, &ToffTicks, TimeoutMs) && (TonTicks+ToffTicks)!=0)
+	{
+		MeasuredBaud=((2*(CPU_FREQ/UART_AUTOBAUD_TIMER_DIV))+((TonTicks+ToffTicks)/2))/(TonTicks+ToffTicks);
+
+		for(Counter=0; Counter<(sizeof(StandardBaudRates)/sizeof(StandardBaudRates[0])); Counter++)
+		{
+			Difference=UART_ABS_DIFF(MeasuredBaud, StandardBaudRates[Counter]);
+			if(Difference <= ((StandardBaudRates[Counter]*UART_AUTOBAUD_TOLERANCE_PERMILLE)/1000))
+			{
+				MeasuredBaud=StandardBaudRates[Counter];
+				break;
+			}
+		}
+
+		OperationStatus=UART_SetBaud(MeasuredBaud);
+		if(OperationStatus == SUCCESSFUL_OPERATION)
+		{
+			*DetectedBaudRate=MeasuredBaud;
+		}
+	}
+
+  #if NODE_RECEIVE_DATA==ENABLE
+	UCSRB |=ReceiverState; //restore the receiver state
+  #endif
+	return OperationStatus;
+}
+#endif
+
+
 /**
  * RETURN      : void
  * PARAMETERS  :SendData has a type of UARTData_t which will be resolved automatically to either u8 or u16 data type
@@ -188,12 +465,303 @@ void UART_init(void)
  */
 void UART_SendDataFrame(UARTData_t SendData,u8 *ErrorCode)
 {
-	*ErrorCode = CBuffer_PushData(&UART_TX_Buffer,SendData); //store the error code after the data push operation to be either SUCCESSFUL_OPERATION or ERROR_BUFFER_FULL
+	*ErrorCode = SPSC_PushData(&UART_TX_Buffer,SendData); //store the error code after the data push operation to be either SUCCESSFUL_OPERATION or ERROR_BUFFER_FULL
 	if(*ErrorCode == SUCCESSFUL_OPERATION) //a successful push operation means that 1 byte of data already stored in the UART_TX_Buffer
 	{
-	    SetRegisterBit(SREG, 7); //enable global interrupt
-	    SetRegisterBit(UCSRB ,UDRIE); //USART Data Register Empty Interrupt Enable , the TX-ISR will pop 1 byte of data at a time from UART_TX_Buffer to UDR reg. to be sent
+	    UART_TX_Start(); //the TX-ISR will pop 1 byte of data at a time from UART_TX_Buffer to UDR reg. to be sent
+	}
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : the block has been accepted and it's transmission has been started
+ *               UART_TX_BUSY         : a previous block is still being transmitted or the UART_TX_Buffer still has unsent frames
+ *               FAILED_OPERATION     : Block is a NULL pointer , BlockLength equals zero or the block transmit mode is disabled
+ * PARAMETERS  : Block is a pointer to the array of frames to be sent "UARTData_t elements"
+ *             : BlockLength is the number of frames in the Block array
+ *             : BlockSent_UserFunction is a pointer to a user defined function to be executed once the last frame of the block
+ *               has been loaded to the UDR register , it can be NULL if no notification is required
+ * DESCRIPTION : This function is used to send a whole block of frames , the TX-ISR will read the frames straight from the user's array
+ *               without copying them into the UART_TX_Buffer
+ * CAUTION     : the user MUST NOT change the content of the Block array till BlockSent_UserFunction is executed
+ *               any frames sent by UART_SendDataFrame() during the block transmission will be sent after the block
+ */
+u8 UART_SendBlock(const UARTData_t *Block, u16 BlockLength, void (*BlockSent_UserFunction)(void))
+{
+	u8 BlockStatus=FAILED_OPERATION; //set BlockStatus as a default value
+#if NODE_TRANSMIT_DATA==ENABLE && UART_BLOCK_TRANSMIT == ENABLE
+	u8 SREG_Copy;
+	if(Block!=NULL && BlockLength>0)
+	{
+		SREG_Copy=SREG; //save the global interrupt state
+		ClearRegisterBit(SREG, 7); //the transmitter is checked and claimed without being interrupted by another sender "ex. the Modbus engine ISR"
+		//the block is accepted only if the TX-ISR has nothing else to send , this keeps the frames order as the TX-ISR gives the block the priority over the UART_TX_Buffer
+		if(TX_BlockActive==FALSE && SPSC_IsTheBufferEmpty(&UART_TX_Buffer))
+		{
+			//all the block variables are volatile so they are stored before TX_BlockActive hands the block over to the TX-ISR
+			TX_BlockPtr=Block;
+			TX_BlockRemaining=BlockLength;
+			TX_BlockSentFunc=BlockSent_UserFunction;
+			TX_BlockActive=TRUE;
+			BlockStatus=SUCCESSFUL_OPERATION;
+		    UART_TX_Start(); //the TX-ISR will load the block frames one at a time to UDR reg.
+		}
+		else
+		{
+			BlockStatus=UART_TX_BUSY;
+		}
+		SREG=SREG_Copy; //restore the global interrupt state
+	}
+#endif
+	return BlockStatus;
+}
+
+
+/**
+ * RETURN      : u16 variable that will contain the number of frames that have been pushed to the UART_TX_Buffer
+ * PARAMETERS  : Source is a pointer to the array of frames to be sent "UARTData_t elements"
+ *             : Count is the number of frames in the Source array
+ * DESCRIPTION : This function is used to push as many frames as the UART_TX_Buffer can hold , the rest of the frames are left for a later call
+ *               the frames are copied by SPSC_PushBlock() and the TX-ISR is started once for the whole call
+ */
+u16 UART_Write(const UARTData_t *Source, u16 Count)
+{
+	u16 Written=0; //number of frames that have been pushed so far
+#if NODE_TRANSMIT_DATA==ENABLE
+	u8 Chunk;
+	u8 Pushed;
+	if(Source!=NULL)
+	{
+		//SPSC_PushBlock() takes an 8bit count , the loop stops as soon as the UART_TX_Buffer is full
+		do
+		{
+			Chunk=((Count-Written)>0xFF)?0xFF:(u8)(Count-Written);
+			Pushed=SPSC_PushBlock(&UART_TX_Buffer, &Source[Written], Chunk);
+			Written+=Pushed;
+		}while(Pushed==Chunk && Written<Count);
+		if(Written>0)
+		{
+		    UART_TX_Start(); //the TX-ISR is started once for all the pushed frames
+		}
+	}
+#endif
+	return Written;
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain the number of free locations in the UART_TX_Buffer
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to know how many frames can be accepted by UART_Write() or UART_SendDataFrame() right now
+ *               the free space can only grow till the next push as the TX-ISR keeps popping frames
+ */
+u8 UART_TxFree(void)
+{
+#if NODE_TRANSMIT_DATA==ENABLE
+	return (u8)(UART_TX_BUFFER_SIZE - SPSC_Count(&UART_TX_Buffer));
+#else
+	return 0;
+#endif
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : all the frames have been sent "the last frame has left the shift register"
+ *               FAILED_OPERATION     : the timeout has elapsed before the transmission is finished
+ * PARAMETERS  : TimeoutMs is the maximum waiting time in milliseconds "ZERO checks the transmitter state once without waiting"
+ * DESCRIPTION : This function is used to wait till the UART_TX_Buffer and any active block are sent completely
+ *               ex. before changing the baud rate or entering a sleep mode
+ * CAUTION     : the global interrupt MUST be enabled and the function MUST NOT be called from an ISR
+ *               frames paused by the CTS line are counted as not sent
+ *               the timeout is counted in CPU_FREQ based polls "no delay functions" , it's the minimum waiting time not an exact one
+ */
+u8 UART_Flush(u16 TimeoutMs)
+{
+	u8 FlushStatus=SUCCESSFUL_OPERATION;
+#if NODE_TRANSMIT_DATA==ENABLE
+	u32 PollCount=(u32)TimeoutMs*UART_FLUSH_POLLS_PER_MS; //the timeout is counted in polls of the transmitter state
+	while(!UART_TX_IsDrained())
+	{
+		if(PollCount==0)
+		{
+			FlushStatus=FAILED_OPERATION;
+			break;
+		}
+		PollCount--;
+	}
+#endif
+	return FlushStatus;
+}
+
+
+/**
+ * RETURN      : u16 variable that will contain the number of characters that have been pushed to the UART_TX_Buffer
+ * PARAMETERS  : Format is the format string and the rest of the arguments are the values to be printed "see UART_Interface.h"
+ * DESCRIPTION : This function is used to format the text straight into the UART_TX_Buffer , the TX-ISR is started once at the end
+ */
+u16 UART_Printf(const char *Format, ...)
+{
+	u16 Written=0;
+#if NODE_TRANSMIT_DATA==ENABLE && UART_PRINTF == ENABLE
+	va_list Args;
+	u8  Status=SUCCESSFUL_OPERATION;
+	u8  Width;
+	u8  ZeroPad;
+	u8  FracDigits;
+	u8  LongArg;
+	s32 SignedValue;
+	u32 Value;
+	const c8 *String;
+
+	va_start(Args, Format);
+	while(*Format != '\0' && Status == SUCCESSFUL_OPERATION)
+	{
+		if(*Format != '%')
+		{
+			Status=SPSC_PushData(&UART_TX_Buffer, (u8)*Format);
+			Written+=(Status == SUCCESSFUL_OPERATION);
+			Format++;
+			continue;
+		}
+
+		//parse the conversion specifier "%[0][width][.N][l]type"
+		Format++;
+		Width=0;
+		ZeroPad=FALSE;
+		FracDigits=0;
+		LongArg=FALSE;
+		if(*Format == '0')
+		{
+			ZeroPad=TRUE;
+			Format++;
+		}
+		while(*Format >= '0' && *Format <= '9')
+		{
+			Width=(Width*10)+(*Format-'0');
+			Format++;
+		}
+		if(*Format == '.')
+		{
+			Format++;
+			while(*Format >= '0' && *Format <= '9')
+			{
+				FracDigits=(FracDigits*10)+(*Format-'0');
+				Format++;
+			}
+		}
+		if(*Format == 'l')
+		{
+			LongArg=TRUE;
+			Format++;
+		}
+
+		switch(*Format)
+		{
+		case 'd':
+		case 'i':
+			SignedValue=(LongArg)?va_arg(Args, s32):(s32)va_arg(Args, s16);
+			Value=(SignedValue < 0)?((u32)0-(u32)SignedValue):(u32)SignedValue;
+			Status=UART_PrintNumber(Value, (SignedValue < 0), 10, FALSE, Width, ZeroPad, FracDigits, &Written);
+			break;
+		case 'u':
+		case 'x':
+		case 'X':
+			Value=(LongArg)?va_arg(Args, u32):(u32)va_arg(Args, u16);
+			Status=UART_PrintNumber(Value, FALSE, (*Format == 'u')?10:16, (*Format == 'X'), Width, ZeroPad, FracDigits, &Written);
+			break;
+		case 'c':
+			Status=SPSC_PushData(&UART_TX_Buffer, (u8)va_arg(Args, s16));
+			Written+=(Status == SUCCESSFUL_OPERATION);
+			break;
+		case 's':
+			String=va_arg(Args, const c8 *);
+			while(String != NULL && *String != '\0' && Status == SUCCESSFUL_OPERATION)
+			{
+				Status=SPSC_PushData(&UART_TX_Buffer, (u8)*String);
+				Written+=(Status == SUCCESSFUL_OPERATION);
+				String++;
+			}
+			break;
+		case '\0': //the format string ended in the middle of a specifier
+			Format--;
+			break;
+		default: //"%%" or an unsupported specifier , the character is sent as it is
+			Status=SPSC_PushData(&UART_TX_Buffer, (u8)*Format);
+			Written+=(Status == SUCCESSFUL_OPERATION);
+			break;
+		}
+		Format++;
+	}
+	va_end(Args);
+
+	if(Written > 0)
+	{
+		UART_TX_Start(); //the TX-ISR is started once for the whole output
+	}
+#endif
+	return Written;
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain SUCCESSFUL_OPERATION , ERROR_BUFFER_FULL or FAILED_OPERATION
+ * PARAMETERS  : Packet is a pointer to the array of bytes to be sent and Length is the number of bytes
+ * DESCRIPTION : This function is used to COBS encode the packet straight into the UART_TX_Buffer
+ *               each block is a code byte "distance to the next ZERO byte" followed by up to 254 non ZERO bytes
+ */
+u8 UART_SendPacket(const u8 *Packet, u8 Length)
+{
+	u8 PacketStatus=FAILED_OPERATION;
+#if NODE_TRANSMIT_DATA==ENABLE && UART_COBS_FRAMING == ENABLE
+	u8 BlockStart=0;
+	u8 BlockLength;
+	u8 Counter;
+	u8 Done=FALSE;
+	if(Packet!=NULL && Length>0)
+	{
+		//the whole encoded packet is pushed or nothing at all , so a full UART_TX_Buffer can't corrupt the stream
+		if((u16)(UART_TX_BUFFER_SIZE - SPSC_Count(&UART_TX_Buffer)) < (u16)Length+2+(Length/COBS_MAX_BLOCK))
+		{
+			PacketStatus=ERROR_BUFFER_FULL;
+		}
+		else
+		{
+			while(Done==FALSE)
+			{
+				BlockLength=0;
+				while((u16)BlockStart+BlockLength < Length && BlockLength < COBS_MAX_BLOCK && Packet[BlockStart+BlockLength] != 0)
+				{
+					BlockLength++;
+				}
+				SPSC_PushData(&UART_TX_Buffer, BlockLength+1); //the code byte
+				for(Counter=0; Counter<BlockLength; Counter++)
+				{
+					SPSC_PushData(&UART_TX_Buffer, Packet[BlockStart+Counter]);
+				}
+				BlockStart+=BlockLength;
+				if(BlockStart >= Length)
+				{
+					Done=TRUE;
+				}
+				else if(BlockLength < COBS_MAX_BLOCK) //the block has been ended by a ZERO byte that is implied by the code byte
+				{
+					BlockStart++;
+					if(BlockStart == Length) //the packet ends with a ZERO byte , it's implied by an empty last block
+					{
+						SPSC_PushData(&UART_TX_Buffer, 1);
+						Done=TRUE;
+					}
+				}
+			}
+			SPSC_PushData(&UART_TX_Buffer, COBS_DELIMITER);
+			PacketStatus=SUCCESSFUL_OPERATION;
+			UART_TX_Start();
+		}
 	}
+#endif
+	return PacketStatus;
 }
 
 
@@ -214,22 +782,30 @@ u8 UART_ReceiveDataFrame(UARTData_t *ReceivedData)
   u8 ErrorValue=0; //error value temporary storage
   #if FRAME_SIZE == _9_BITS_FRAME //in 9bits frames each UART_RX_Buffer slot "2bytes" the RX-ISR will store the data at the first 9bits and the error value at the last 3bits
    u16 DataAndErrorFrame=0; //temporary storage to hold the data and error value
-   if(!CBuffer_IsTheBufferEmpty(&UART_RX_Buffer))
+   if(!SPSC_IsTheBufferEmpty(&UART_RX_Buffer))
     {
-      CBuffer_PopData(&UART_RX_Buffer, &DataAndErrorFrame); //pop 1 slot of the UART_RX_Buffer and store it in DataAndErrorFrame variable
+      SPSC_PopData(&UART_RX_Buffer, &DataAndErrorFrame); //pop 1 slot of the UART_RX_Buffer and store it in DataAndErrorFrame variable
       *ReceivedData =DataAndErrorFrame & 0x01FF; // exclude the the data frame "9bits" from the DataAndErrorFrame variable
        ErrorValue = ((u8)((DataAndErrorFrame & 0xE000)>>13)); //exclude the error value from DataAndErrorFrame and store it in ErrorValue to be the return value
+       RX_PoppedFrameIndex++;
+      #if UART_FLOW_CONTROL == ENABLE
+       UART_RTS_CheckLowWatermark();
+      #endif
      }
    else
      {
 	  ErrorValue = ERROR_BUFFER_EMPTY; // in case the UART_RX_Buffer is empty , the error value will equal ERROR_BUFFER_EMPTY
      }
 
-  #else // in case of 8bit or less frames error value will be stored in a separate ErrorBuffer has same size as UART_RX_Buffer
-   if(!CBuffer_IsTheBufferEmpty(&UART_RX_Buffer))
+  #else // in case of 8bit or less frames only the frames received with errors are recorded in the RX_ErrorLog
+   if(!SPSC_IsTheBufferEmpty(&UART_RX_Buffer))
    {
-      CBuffer_PopData(&UART_RX_Buffer, ReceivedData); //pop the data from UART_RX_Buffer and store it where ReceivedData points at
-      CBuffer_PopData(&RX_ErrorBuffer,&ErrorValue);//pop the the error value corresponds to the relative data frame and store it in ErrorValue
+      SPSC_PopData(&UART_RX_Buffer, ReceivedData); //pop the data from UART_RX_Buffer and store it where ReceivedData points at
+      ErrorValue=UART_PopFrameErrorValue(); //get the error value corresponds to the popped data frame "ZERO if it's not recorded in the RX_ErrorLog"
+      RX_PoppedFrameIndex++;
+     #if UART_FLOW_CONTROL == ENABLE
+      UART_RTS_CheckLowWatermark();
+     #endif
    }
    else
    {
@@ -242,52 +818,207 @@ u8 UART_ReceiveDataFrame(UARTData_t *ReceivedData)
 }
 
 
+/**
+ * RETURN      : u8 variable that will contain the number of frames that have been copied to ReceivedData
+ * PARAMETERS  : ReceivedData is a pointer to an array of UARTData_t elements where the received frames will be stored
+ *             : Count is the maximum number of frames to be read
+ *             : ErrorValue is a pointer to u8 variable where the combined "ORed" error values of all the read frames will be stored
+ * DESCRIPTION : This function is used to read up to Count frames from the UART_RX_Buffer in a single call
+ */
+u8 UART_ReceiveBlock(UARTData_t *ReceivedData, u8 Count, u8 *ErrorValue)
+{
+	u8 ReadCount=0;
+	*ErrorValue=0;
+#if NODE_RECEIVE_DATA==ENABLE
+	u8 Tail;
+	ReadCount=SPSC_PopBlock(&UART_RX_Buffer, ReceivedData, Count); //copy the frames out of the UART_RX_Buffer , their locations are released to the RX-ISR at once
+  #if FRAME_SIZE == _9_BITS_FRAME //the error value of each frame is stored in the last 3bits of it's slot
+	for(Tail=0;Tail<ReadCount;Tail++)
+	{
+		*ErrorValue |= ((u8)((ReceivedData[Tail] & 0xE000)>>13));
+		ReceivedData[Tail] &= 0x01FF;
+	}
+  #else //remove the log entries of the read frames "the log entries are ordered by the frame index"
+	Tail=RX_ErrorLogTail;
+	while(Tail != RX_ErrorLogHead && (u8)(RX_ErrorLog[Tail & RX_ERROR_LOG_MASK].FrameIndex - RX_PoppedFrameIndex) < ReadCount)
+	{
+		*ErrorValue |= RX_ErrorLog[Tail & RX_ERROR_LOG_MASK].ErrorValue;
+		Tail++;
+	}
+	RX_ErrorLogTail=Tail;
+  #endif
+	RX_PoppedFrameIndex+=ReadCount;
+  #if UART_FLOW_CONTROL == ENABLE
+	UART_RTS_CheckLowWatermark();
+  #endif
+#endif
+	return ReadCount;
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain one of the following values
+ *               SUCCESSFUL_OPERATION : a complete packet descriptor has been stored in Packet
+ *               ERROR_BUFFER_EMPTY   : there are no complete packets yet
+ *               FAILED_OPERATION     : the idle line packet framing mode is disabled
+ * PARAMETERS  : Packet is a pointer to a UART_PacketDescriptor_t variable where the packet descriptor will be stored
+ * DESCRIPTION : This function is used in the idle line packet framing mode to get the descriptor of the oldest complete packet
+ *               any unread frames that belong to the previous packets are discarded so the next frame in the UART_RX_Buffer is the first frame of the packet
+ *               the packet frames can then be read by calling UART_ReceiveBlock() with Count = Packet->Length
+ */
+u8 UART_GetPacket(UART_PacketDescriptor_t *Packet)
+{
+	u8 PacketStatus=FAILED_OPERATION;
+#if NODE_RECEIVE_DATA==ENABLE && UART_PACKET_QUEUE == ENABLE
+	UARTData_t DiscardedFrame;
+	u8 Discard;
+	u8 Tail=RX_PacketQueueTail;
+	if(Tail != RX_PacketQueueHead)
+	{
+		Packet->StartIndex=RX_PacketQueue[Tail & PACKET_QUEUE_MASK].StartIndex;
+		Packet->Length    =RX_PacketQueue[Tail & PACKET_QUEUE_MASK].Length;
+		Packet->Status    =RX_PacketQueue[Tail & PACKET_QUEUE_MASK].Status;
+	  #if UART_RUNNING_CRC == ENABLE
+		Packet->CRC       =RX_PacketQueue[Tail & PACKET_QUEUE_MASK].CRC;
+	  #endif
+		RX_PacketQueueTail=Tail+1;
+		//discard the unread frames of the previous packets "ex. a packet whose descriptor was lost as the queue was full"
+		//the distance to the packet start is bounded by the number of frames held in the UART_RX_Buffer , a larger distance means
+		//that the packet start has already been read so nothing is discarded
+		Discard=(u8)(Packet->StartIndex - RX_PoppedFrameIndex);
+		if(Discard <= SPSC_Count(&UART_RX_Buffer))
+		{
+			while(Discard > 0)
+			{
+				UART_ReceiveDataFrame(&DiscardedFrame);
+				Discard--;
+			}
+		}
+		PacketStatus=SUCCESSFUL_OPERATION;
+	}
+	else
+	{
+		PacketStatus=ERROR_BUFFER_EMPTY;
+	}
+#endif
+	return PacketStatus;
+}
+
+
+/**
+ * RETURN      : u8 variable that will contain SUCCESSFUL_OPERATION , UART_LINE_TRUNCATED , ERROR_BUFFER_EMPTY or FAILED_OPERATION
+ * PARAMETERS  : Line is a pointer to the user's array , MaxLength is it's size
+ *               LineLength and ErrorValue are pointers to u8 variables where the line length and it's error value will be stored
+ * DESCRIPTION : This function is used to read the oldest complete line from the RX_Buffer
+ */
+u8 UART_ReadLine(UARTData_t *Line, u8 MaxLength, u8 *LineLength, u8 *ErrorValue)
+{
+	u8 LineStatus=FAILED_OPERATION;
+	*LineLength=0;
+	*ErrorValue=0;
+#if NODE_RECEIVE_DATA==ENABLE && UART_LINE_FRAMING == ENABLE
+	UART_PacketDescriptor_t LineDescriptor;
+	UARTData_t DiscardedFrame;
+	u8 Remaining;
+	LineStatus=UART_GetPacket(&LineDescriptor);
+	if(LineStatus == SUCCESSFUL_OPERATION)
+	{
+		if(LineDescriptor.Length > MaxLength)
+		{
+			LineStatus=UART_LINE_TRUNCATED;
+			Remaining=LineDescriptor.Length-MaxLength;
+			LineDescriptor.Length=MaxLength;
+		}
+		else
+		{
+			Remaining=0;
+		}
+		*LineLength=UART_ReceiveBlock(Line, LineDescriptor.Length, ErrorValue);
+		while(Remaining > 0) //discard the rest of the truncated line
+		{
+			*ErrorValue|=UART_ReceiveDataFrame(&DiscardedFrame);
+			Remaining--;
+		}
+		if(LineDescriptor.Status & PACKET_FRAMES_DROPPED)
+		{
+			*ErrorValue|=(PACKET_FRAMES_DROPPED<<4);
+		}
+	}
+#endif
+	return LineStatus;
+}
+
+
+/**
+ * RETURN      : pointer to the first frame of the complete record or NULL if there is no complete record yet
+ * PARAMETERS  : ErrorValue is a pointer to u8 variable where the combined "ORed" error values of the record frames will be stored
+ * DESCRIPTION : This function is used in the ping-pong RX record mode to get the complete record , the record is read in place
+ *               and stays valid till UART_ReleaseRecord() is called
+ */
+const UARTData_t* UART_GetRecord(u8 *ErrorValue)
+{
+#if NODE_RECEIVE_DATA==ENABLE && UART_PINGPONG_RX == ENABLE
+	if(RX_RecordReady)
+	{
+		//RX_FillingHalf doesn't change while RX_RecordReady is TRUE
+		*ErrorValue=RX_RecordErrors[RX_FillingHalf^1];
+		return RX_Records[RX_FillingHalf^1];
+	}
+#endif
+	return NULL;
+}
+
+
 /**
  * RETURN      : void
  * PARAMETERS  : void
- * DESCRIPTION : this function is used to stop the transmitter
- * CAUTION     : the use of this function will clear all the unsent data store in the UART_TX_Buffer
+ * DESCRIPTION : This function is used in the ping-pong RX record mode to give the record back to the RX-ISR once it has been processed
  */
-void UART_TransmitterStop(void)
+void UART_ReleaseRecord(void)
 {
-#if NODE_TRANSMIT_DATA==ENABLE
-    ClearRegisterBit(UCSRB, TXEN);  //Transmitter Disable
-    ClearRegisterBit(UCSRB, UDRIE); //Disable USART Data Register Empty Interrupt
-    CBuffer_BufferReset(& UART_TX_Buffer); //Clear the TX buffer
+#if NODE_RECEIVE_DATA==ENABLE && UART_PINGPONG_RX == ENABLE
+	RX_RecordReady=FALSE;
 #endif
 }
 
 
 /**
- * RETURN      : void
+ * RETURN      : u8 variable that will be TRUE if any record has been dropped since the last call or FALSE otherwise
  * PARAMETERS  : void
- * DESCRIPTION : This function is used to re-enable the transmitter functionality after it's being disabled
+ * DESCRIPTION : This function is used in the ping-pong RX record mode to read and clear the record overrun flag
  */
-void UART_Transmitter_ReEnable(void)
+u8 UART_RecordOverrun(void)
 {
-#if NODE_TRANSMIT_DATA==ENABLE
-	SetRegisterBit(SREG, 7); //enable global interrupt
-	SetRegisterBit(UCSRB ,UDRIE); //Enable USART Data Register Empty Interrupt
-	SetRegisterBit(UCSRB,TXEN);   //Enable Transmitter
+	u8 Overrun=FALSE;
+#if NODE_RECEIVE_DATA==ENABLE && UART_PINGPONG_RX == ENABLE
+	u8 SREG_Copy=SREG;
+	ClearRegisterBit(SREG, 7); //the flag is read and cleared without being interrupted by the RX-ISR
+	Overrun=RX_RecordOverrun;
+	RX_RecordOverrun=FALSE;
+	SREG=SREG_Copy; //restore the global interrupt state
 #endif
+	return Overrun;
 }
 
 
 /**
  * RETURN      : void
- * PARAMETERS  : void
- * DESCRIPTION : this function is used to disable the receiver
- * CAUTION     : the use of this function will clear all the unread data stored in the UART_RX_Buffer
+ * PARAMETERS  : Stats is a pointer to a UART_RxStats_t variable that has to be defined by the user
+ * DESCRIPTION : This function is used to take a consistent snapshot of the receiver statistics
  */
-void UART_ReceiverStop(void)
+void UART_GetRxStats(UART_RxStats_t *Stats)
 {
 #if NODE_RECEIVE_DATA==ENABLE
-	ClearRegisterBit(UCSRB,RXCIE);//Disable RX Complete Interrupt
-	ClearRegisterBit(UCSRB,RXEN); //Disable Receiver
-	CBuffer_BufferReset(& UART_RX_Buffer); //Clear the RX buffer
-    #if FRAME_SIZE != _9_BITS_FRAME
-	CBuffer_BufferReset(&RX_ErrorBuffer); //Clear the RX error buffer
-    #endif
+	u8 SREG_Copy=SREG; //save the global interrupt state
+	ClearRegisterBit(SREG, 7); //disable the global interrupt while the multi byte counters are being copied
+	Stats->FramesReceived=RX_Stats.FramesReceived;
+	Stats->FramesDropped =RX_Stats.FramesDropped;
+	Stats->ParityErrors  =RX_Stats.ParityErrors;
+	Stats->OverrunErrors =RX_Stats.OverrunErrors;
+	Stats->FrameErrors   =RX_Stats.FrameErrors;
+	Stats->LostErrorLogs =RX_Stats.LostErrorLogs;
+	Stats->HighWaterMark =RX_Stats.HighWaterMark;
+	SREG=SREG_Copy; //restore the global interrupt state
 #endif
 }
 
@@ -295,81 +1026,887 @@ void UART_ReceiverStop(void)
 /**
  * RETURN      : void
  * PARAMETERS  : void
- * DESCRIPTION : This function is used to re-enable the receiver functionality after it's being disabled
+ * DESCRIPTION : This function is used to clear the receiver statistics
  */
-void UART_Receiver_ReEnable(void)
+void UART_ResetRxStats(void)
 {
 #if NODE_RECEIVE_DATA==ENABLE
-	SetRegisterBit(SREG, 7); //enable global interrupt
-	SetRegisterBit(UCSRB ,RXCIE); //Enable RX Complete Interrupt
-	SetRegisterBit(UCSRB,RXEN);   //Enable Receiver
+	u8 SREG_Copy=SREG; //save the global interrupt state
+	ClearRegisterBit(SREG, 7); //disable the global interrupt while the counters are being cleared
+	RX_Stats.FramesReceived=0;
+	RX_Stats.FramesDropped =0;
+	RX_Stats.ParityErrors  =0;
+	RX_Stats.OverrunErrors =0;
+	RX_Stats.FrameErrors   =0;
+	RX_Stats.LostErrorLogs =0;
+	RX_Stats.HighWaterMark =0;
+	SREG=SREG_Copy; //restore the global interrupt state
 #endif
 }
 
 
-
 /**
- *
+ * RETURN      : void
+ * PARAMETERS  : Packet_UserFunction is a pointer to the user's function
+ * DESCRIPTION : This function is used to mount the user's function to be executed on each complete packet
  */
-#if NODE_TRANSMIT_DATA==ENABLE
-void __vector_14 (void) __attribute__ ((signal,used));
-void __vector_14 (void)
+void UART_ExecuteOnPacket(void (*Packet_UserFunction)(void))
 {
-	UARTData_t TX_Data;
-
-    if(!CBuffer_IsTheBufferEmpty(&UART_TX_Buffer))
-    {
-    	CBuffer_PopData(&UART_TX_Buffer, &TX_Data);
-       #if(FRAME_SIZE == _9_BITS_FRAME)
-    	{
-    	 if (TX_Data & 0x100 ) //check if the ninth bit in the TX_data=1 if so set TXB8 to 1
-    	  {
-    	  SetRegisterBit(UCSRB,TXB8); //set the TXB8 to 1
-    	  }
-    	 else
-    	  {
-    	  ClearRegisterBit(UCSRB,TXB8); //clear the ninth bit
-    	  }
-    	}
-       #endif
-    	UDR=TX_Data; //load data from UART_TX_Buffer to UDR register to initiate data sending
-    }
-    else
-    {
-    	ClearRegisterBit(UCSRB, UDRIE); //Disable USART Data Register Empty Interrupt
-    }
-}
+#if NODE_RECEIVE_DATA==ENABLE && UART_PACKET_QUEUE == ENABLE
+	if(Packet_UserFunction)
+	{
+		RX_PacketFunc=Packet_UserFunction; //mount the user's function
+	}
 #endif
+}
 
 
-#if NODE_RECEIVE_DATA==ENABLE
-void __vector_13 (void) __attribute__ ((signal,used));
-void __vector_13 (void)
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function that is executed on each complete packet
+ */
+void UART_Packet_UserFnDisable(void)
 {
-	 u8 FrameErrorLog=0; //temporary storage for the error value
-	 UARTData_t RX_Data=0; //data frame temporary storage,RX_Date size will depend on the frame size "2bytes in case of 9bits frame and 1byte for the rest"
+#if NODE_RECEIVE_DATA==ENABLE && UART_PACKET_QUEUE == ENABLE
+	RX_PacketFunc=NULL; //unmount the user's function by setting RX_PacketFunc to NULL
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : Record_UserFunction is a pointer to the user's function
+ * DESCRIPTION : This function is used to mount the user's function to be executed on each complete record in the ping-pong RX record mode
+ */
+void UART_ExecuteOnRecord(void (*Record_UserFunction)(void))
+{
+#if NODE_RECEIVE_DATA==ENABLE && UART_PINGPONG_RX == ENABLE
+	if(Record_UserFunction)
+	{
+		RX_RecordFunc=Record_UserFunction; //mount the user's function
+	}
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function that is executed on each complete record
+ */
+void UART_Record_UserFnDisable(void)
+{
+#if NODE_RECEIVE_DATA==ENABLE && UART_PINGPONG_RX == ENABLE
+	RX_RecordFunc=NULL; //unmount the user's function by setting RX_RecordFunc to NULL
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : Receive_UserFunction is a pointer to the user's function , Threshold is the number of unread frames that triggers it
+ * DESCRIPTION : This function is used to mount the user's function on the RX complete interrupt
+ */
+void UART_ExecuteOnReceive(void (*Receive_UserFunction)(void), u8 Threshold)
+{
+#if NODE_RECEIVE_DATA==ENABLE
+	if(Receive_UserFunction)
+	{
+		RX_ReceiveThreshold=(Threshold==0)?1:Threshold;
+		RX_ReceiveFunc=Receive_UserFunction; //mount the user's function
+	}
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function from the RX complete interrupt
+ */
+void UART_Receive_UserFnDisable(void)
+{
+#if NODE_RECEIVE_DATA==ENABLE
+	RX_ReceiveFunc=NULL; //unmount the user's function by setting RX_ReceiveFunc to NULL
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : TxEmpty_UserFunction is a pointer to the user's function
+ * DESCRIPTION : This function is used to mount the user's function on the data register empty interrupt
+ */
+void UART_ExecuteOnTxEmpty(void (*TxEmpty_UserFunction)(void))
+{
+#if NODE_TRANSMIT_DATA==ENABLE
+	if(TxEmpty_UserFunction)
+	{
+		TX_EmptyFunc=TxEmpty_UserFunction; //mount the user's function
+	}
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to unmount the user's function from the data register empty interrupt
+ */
+void UART_TxEmpty_UserFnDisable(void)
+{
+#if NODE_TRANSMIT_DATA==ENABLE
+	TX_EmptyFunc=NULL; //unmount the user's function by setting TX_EmptyFunc to NULL
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to restart the running RX CRC
+ */
+void UART_RxCRC_Reset(void)
+{
+#if NODE_RECEIVE_DATA==ENABLE && UART_RUNNING_CRC == ENABLE
+	u8 SREG_Copy=SREG; //save the global interrupt state
+	ClearRegisterBit(SREG, 7); //the multi byte CRC register is shared with the RX-ISR
+	RX_CRC_Register=UART_CRC_INIT;
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
+}
+
+
+/**
+ * RETURN      : UART_CRC_t variable that will contain the CRC of the frames received since the last reset
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to read the running RX CRC
+ */
+UART_CRC_t UART_RxCRC_Get(void)
+{
+	UART_CRC_t CRC=0;
+#if NODE_RECEIVE_DATA==ENABLE && UART_RUNNING_CRC == ENABLE
+	u8 SREG_Copy=SREG; //save the global interrupt state
+	ClearRegisterBit(SREG, 7); //the multi byte CRC register is shared with the RX-ISR
+	CRC=RX_CRC_Register^UART_CRC_FINAL_XOR;
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
+	return CRC;
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to restart the running TX CRC
+ */
+void UART_TxCRC_Reset(void)
+{
+#if NODE_TRANSMIT_DATA==ENABLE && UART_RUNNING_CRC == ENABLE
+	u8 SREG_Copy=SREG; //save the global interrupt state
+	ClearRegisterBit(SREG, 7); //the multi byte CRC register is shared with the TX-ISR
+	TX_CRC_Register=UART_CRC_INIT;
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
+}
+
+
+/**
+ * RETURN      : UART_CRC_t variable that will contain the CRC of the frames loaded to UDR since the last reset
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to read the running TX CRC
+ */
+UART_CRC_t UART_TxCRC_Get(void)
+{
+	UART_CRC_t CRC=0;
+#if NODE_TRANSMIT_DATA==ENABLE && UART_RUNNING_CRC == ENABLE
+	u8 SREG_Copy=SREG; //save the global interrupt state
+	ClearRegisterBit(SREG, 7); //the multi byte CRC register is shared with the TX-ISR
+	CRC=TX_CRC_Register^UART_CRC_FINAL_XOR;
+	SREG=SREG_Copy; //restore the global interrupt state
+#endif
+	return CRC;
+}
+
+
+/**
+ * RETURN      : UART_CRC_t variable that will contain the CRC of the given array
+ * PARAMETERS  : Data is a pointer to the array of bytes and Length is the number of bytes
+ * DESCRIPTION : This function is used to calculate the CRC of an array with the selected CRC algorithm
+ */
+UART_CRC_t UART_CRC_Calc(const u8 *Data, u16 Length)
+{
+	UART_CRC_t CRC=UART_CRC_INIT;
+#if UART_RUNNING_CRC == ENABLE
+	while(Length > 0)
+	{
+		CRC=UART_CRC_Update(CRC, *Data);
+		Data++;
+		Length--;
+	}
+#endif
+	return CRC^UART_CRC_FINAL_XOR;
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : this function is used to stop the transmitter
+ * CAUTION     : the use of this function will clear all the unsent data store in the UART_TX_Buffer
+ */
+void UART_TransmitterStop(void)
+{
+#if NODE_TRANSMIT_DATA==ENABLE
+    ClearRegisterBit(UCSRB, TXEN);  //Transmitter Disable
+    ClearRegisterBit(UCSRB, UDRIE); //Disable USART Data Register Empty Interrupt
+    SPSC_BufferReset(&UART_TX_Buffer); //Clear the TX buffer
+   #if UART_BLOCK_TRANSMIT == ENABLE
+    TX_BlockActive=FALSE; //drop the unsent part of the block "if any"
+    TX_BlockRemaining=0;
+    TX_BlockSentFunc=NULL;
+   #endif
+   #if UART_RS485_DE_CONTROL == ENABLE
+    ClearRegisterBit(UCSRB, TXCIE); //Disable TX Complete Interrupt
+    SetPinValue(UART_DE_PORT, UART_DE_PIN, !UART_DE_ACTIVE_LEVEL); //release the bus
+   #endif
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to re-enable the transmitter functionality after it's being disabled
+ */
+void UART_Transmitter_ReEnable(void)
+{
+#if NODE_TRANSMIT_DATA==ENABLE
+	SetRegisterBit(UCSRB,TXEN);   //Enable Transmitter
+	if(!SPSC_IsTheBufferEmpty(&UART_TX_Buffer)) //the TX-ISR is only started if there is something to send
+	{
+		UART_TX_Start();
+	}
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : this function is used to disable the receiver
+ * CAUTION     : the use of this function will clear all the unread data stored in the UART_RX_Buffer
+ */
+void UART_ReceiverStop(void)
+{
+#if NODE_RECEIVE_DATA==ENABLE
+	ClearRegisterBit(UCSRB,RXCIE);//Disable RX Complete Interrupt
+	ClearRegisterBit(UCSRB,RXEN); //Disable Receiver
+	SPSC_BufferReset(&UART_RX_Buffer); //Clear the RX buffer
+    #if FRAME_SIZE != _9_BITS_FRAME
+	RX_ErrorLogHead=RX_ErrorLogTail=0; //Clear the RX error log
+    #endif
+	RX_PushedFrameIndex=RX_PoppedFrameIndex=0;
+    #if UART_PACKET_QUEUE == ENABLE
+	RX_PacketQueueHead=RX_PacketQueueTail=0; //Clear the packet queue and drop the packet that is being received
+	RX_PacketOpen=FALSE;
+    #endif
+    #if UART_COBS_FRAMING == ENABLE
+	RX_CobsCodeRemaining=0; //resynchronize on the next delimiter
+	RX_CobsZeroPending=FALSE;
+    #endif
+    #if UART_FLOW_CONTROL == ENABLE
+	SetPinValue(UART_RTS_PORT, UART_RTS_PIN, !UART_FLOW_ACTIVE_LEVEL); //the remote node mustn't send while the receiver is disabled
+    #endif
+#endif
+}
+
+
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : This function is used to re-enable the receiver functionality after it's being disabled
+ */
+void UART_Receiver_ReEnable(void)
+{
+#if NODE_RECEIVE_DATA==ENABLE
+    #if UART_MULTIPROCESSOR_MODE == ENABLE
+	UART_SetMPCM(); //wait for the next address frame
+    #endif
+    #if UART_FLOW_CONTROL == ENABLE
+	RX_RTS_Deasserted=FALSE;
+	SetPinValue(UART_RTS_PORT, UART_RTS_PIN, UART_FLOW_ACTIVE_LEVEL); //the RX_Buffer has been cleared by UART_ReceiverStop()
+    #endif
+	SetRegisterBit(SREG, 7); //enable global interrupt
+	SetRegisterBit(UCSRB ,RXCIE); //Enable RX Complete Interrupt
+	SetRegisterBit(UCSRB,RXEN);   //Enable Receiver
+#endif
+}
+
+
+
+/**
+ *
+ */
+#if NODE_TRANSMIT_DATA==ENABLE
+void __vector_14 (void) __attribute__ ((signal,used));
+void __vector_14 (void)
+{
+	UARTData_t TX_Data;
+	u8 TX_DataReady=TRUE; //will be set to FALSE if there is nothing left to be sent
+
+  #if UART_FLOW_CONTROL == ENABLE
+    if(GetPinValue(UART_CTS_PORT, UART_CTS_PIN) != UART_FLOW_ACTIVE_LEVEL) //the remote node isn't ready , pause till UART_CTS_StateChanged() is called
+    {
+    	ClearRegisterBit(UCSRB, UDRIE); //Disable USART Data Register Empty Interrupt
+    	return;
+    }
+  #endif
+
+  #if UART_BLOCK_TRANSMIT == ENABLE
+    if(TX_BlockActive) //a block is being transmitted , read the next frame straight from the user's array
+    {
+    	TX_Data=*TX_BlockPtr;
+    	TX_BlockPtr++;
+    	TX_BlockRemaining--;
+    	if(TX_BlockRemaining==0) //the last frame of the block is being loaded to UDR , the user's array is free now
+    	{
+    		TX_BlockActive=FALSE;
+    		if(TX_BlockSentFunc!=NULL)
+    		{
+    			TX_BlockSentFunc(); //execute the user's function as the block has been sent
+    		}
+    	}
+    }
+    else
+  #endif
+    if(SPSC_PopData(&UART_TX_Buffer, &TX_Data)!=SUCCESSFUL_OPERATION) //the UART_TX_Buffer is empty
+    {
+    	TX_DataReady=FALSE;
+    	ClearRegisterBit(UCSRB, UDRIE); //Disable USART Data Register Empty Interrupt
+      #if UART_RS485_DE_CONTROL == ENABLE
+    	SetRegisterBit(UCSRB, TXCIE); //the DE pin will be released by the TX complete ISR once the last frame leaves the shift register
+      #endif
+    	if(TX_EmptyFunc!=NULL)
+    	{
+    		TX_EmptyFunc(); //execute the user's function as there is nothing left to be sent
+    	}
+    }
+
+    if(TX_DataReady)
+    {
+       #if(FRAME_SIZE == _9_BITS_FRAME)
+    	{
+    	 if (TX_Data & 0x100 ) //check if the ninth bit in the TX_data=1 if so set TXB8 to 1
+    	  {
+    	  SetRegisterBit(UCSRB,TXB8); //set the TXB8 to 1
+    	  }
+    	 else
+    	  {
+    	  ClearRegisterBit(UCSRB,TXB8); //clear the ninth bit
+    	  }
+    	}
+       #endif
+    	SetRegisterBit(UCSRA, TXC); //writing ONE clears the TXC flag , so it's only set after the last loaded frame has been sent
+    	UDR=TX_Data; //load data to UDR register to initiate data sending
+      #if UART_RUNNING_CRC == ENABLE
+    	TX_CRC_Register=UART_CRC_Update(TX_CRC_Register, (u8)TX_Data); //the CRC is updated while the frame is being shifted out
+      #endif
+    }
+}
+#endif
+
+
+#if NODE_TRANSMIT_DATA==ENABLE && UART_RS485_DE_CONTROL == ENABLE
+/**
+ * TX complete ISR , executed once the last frame has been shifted out and there is no new data in UDR
+ */
+void __vector_15 (void) __attribute__ ((signal,used));
+void __vector_15 (void)
+{
+	ClearRegisterBit(UCSRB, TXCIE); //Disable TX Complete Interrupt
+	if(!GetRegisterBit(UCSRB, UDRIE)) //make sure that no new transmission has been started
+	{
+		SetPinValue(UART_DE_PORT, UART_DE_PIN, !UART_DE_ACTIVE_LEVEL); //release the bus
+	}
+}
+#endif
+
+
+#if NODE_RECEIVE_DATA==ENABLE
+void __vector_13 (void) __attribute__ ((signal,used));
+void __vector_13 (void)
+{
+	 u8 FrameErrorLog=0; //temporary storage for the error value
+	 UARTData_t RX_Data=0; //data frame temporary storage,RX_Date size will depend on the frame size "2bytes in case of 9bits frame and 1byte for the rest"
+	 u8 FillLevel; //number of unread frames in the UART_RX_Buffer after the push operation
+	 u8 PushFrame=TRUE; //set to FALSE if the received frame shouldn't be stored "ex. a COBS code byte"
 
      //get the PE,DOR and FE error values from UCSRA and store them in the first 3 bits of the FrameErrorLog variable
 	 FrameErrorLog = ((GetRegisterBit(UCSRA,PE)<<PE) | (GetRegisterBit(UCSRA,DOR)<<DOR) | (GetRegisterBit(UCSRA,FE)<<FE)) >> 2;
   #if FRAME_SIZE == _9_BITS_FRAME
-	RX_Data =GetRegisterBit(UCSRB,TXB8)<<8; //in case of a 9bits frame store the ninth bit in it's relative location in RX_Data variable
+	RX_Data =GetRegisterBit(UCSRB,RXB8)<<8; //in case of a 9bits frame store the ninth bit in it's relative location in RX_Data variable "RXB8 MUST be read before UDR"
+  #endif
+	RX_Data |= UDR; //store the data from UDR register to the RX_Data variable
+
+  #if UART_MULTIPROCESSOR_MODE == ENABLE
+	if(RX_Data & UART_ADDRESS_FRAME) //data frames are only received while MPCM is cleared , so any address frame decides if this node is addressed
+	{
+		if((((u8)RX_Data) == UART_NODE_ADDRESS) || (((u8)RX_Data) == UART_BROADCAST_ADDRESS))
+		{
+			UART_ClearMPCM(); //receive the following data frames
+		}
+		else
+		{
+			UART_SetMPCM(); //the packet belongs to another node , ignore it's data frames
+			return;
+		}
+	}
   #endif
-	RX_Data = UDR; //store the data from UDR register to the RX_Data variable
 
   #if FRAME_SIZE ==_9_BITS_FRAME
 	RX_Data |=FrameErrorLog <<13; //in case of a 9bits frame the error values of BE,DOR and FE will be stored in the last 3bits of RX_Data
-  #else //in case of a NON 9bits frame the error values will be stored in a separated buffer it's size equals to UART_RX_Buffer
-    CBuffer_PushData(&RX_ErrorBuffer, FrameErrorLog); //store the error value of the received data frame to the RX_ErrorBuffer
   #endif
 
-  if(!CBuffer_IsTheBufferFull(&UART_RX_Buffer))
+  RX_Stats.FramesReceived++;
+  if(FrameErrorLog) //errors are rare so the error counters are only touched when an error occurs
   {
-   CBuffer_PushData(&UART_RX_Buffer, RX_Data); //store the data in the UART_RX_Buffer
+	  if(FrameErrorLog & RX_PARITY_ERROR)
+	  {
+		  RX_Stats.ParityErrors++;
+	  }
+	  if(FrameErrorLog & RX_OVERRUN_ERROR)
+	  {
+		  RX_Stats.OverrunErrors++;
+	  }
+	  if(FrameErrorLog & RX_FRAME_ERROR)
+	  {
+		  RX_Stats.FrameErrors++;
+	  }
+  }
+
+  #if UART_COBS_FRAMING == ENABLE //incremental COBS decoder , constant work per received frame
+	if(RX_Data == COBS_DELIMITER) //end of the packet
+	{
+		if(RX_PacketOpen)
+		{
+			if(RX_CobsCodeRemaining != 0 || (RX_OpenPacket.Status & PACKET_FRAMES_DROPPED))
+			{
+				RX_PacketOpen=FALSE; //corrupted packet , it's frames will be discarded by the next UART_GetPacket() call
+			}
+			else
+			{
+				UART_ClosePacket();
+			}
+		}
+		RX_CobsCodeRemaining=0; //the next frame is the first code byte of a new packet
+		RX_CobsZeroPending=FALSE;
+		return;
+	}
+	else if(RX_CobsCodeRemaining == 0) //code byte , the previous block implied ZERO "if any" is stored instead of it
+	{
+		RX_CobsCodeRemaining=RX_Data-1;
+		PushFrame=RX_CobsZeroPending;
+		RX_CobsZeroPending=(RX_Data != (COBS_MAX_BLOCK+1));
+		RX_Data=0;
+	}
+	else
+	{
+		RX_CobsCodeRemaining--;
+	}
+  #endif
+
+  #if UART_IDLE_LINE_FRAMING == ENABLE
+	UART_IdleTimerRestart(); //a frame has been received so the idle gap measurement starts over
+    #if UART_INTERCHAR_GAP_HALF_CHARS != 0
+	//the idle time is measured from the end of the previous frame so it includes this frame time "2 half characters"
+	if(RX_PacketOpen && RX_IdleHalfChars >= (UART_INTERCHAR_GAP_HALF_CHARS+2))
+	{
+		RX_OpenPacket.Status|=PACKET_GAP_EXCEEDED;
+	}
+    #endif
+	RX_IdleHalfChars=0;
+  #endif
+  #if UART_PACKET_QUEUE == ENABLE
+	if(RX_PacketOpen==FALSE) //this is the first frame of a new packet
+	{
+		RX_OpenPacket.StartIndex=RX_PushedFrameIndex;
+		RX_OpenPacket.Length=0;
+		RX_OpenPacket.Status=0;
+		RX_PacketOpen=TRUE;
+      #if UART_RUNNING_CRC == ENABLE
+		RX_CRC_Register=UART_CRC_INIT; //each packet has it's own CRC
+      #endif
+	}
+  #endif
+  #if UART_RUNNING_CRC == ENABLE
+	if(PushFrame) //in the COBS framing mode the CRC covers the decoded frames only
+	{
+		RX_CRC_Register=UART_CRC_Update(RX_CRC_Register, (u8)RX_Data);
+	}
+  #endif
+
+  #if UART_PINGPONG_RX == ENABLE //the frame is stored in the filling half , the UART_RX_Buffer isn't used in this mode
+	RX_Records[RX_FillingHalf][RX_RecordFill]=RX_Data;
+	RX_RecordErrors[RX_FillingHalf]|=FrameErrorLog;
+	RX_RecordFill++;
+	if(RX_RecordFill==UART_RECORD_LENGTH)
+	{
+		RX_RecordFill=0;
+		if(RX_RecordReady==FALSE) //the other half has been released , swap the halves
+		{
+			RX_RecordReady=TRUE;
+			RX_FillingHalf^=1;
+			RX_RecordErrors[RX_FillingHalf]=0;
+			if(RX_RecordFunc!=NULL)
+			{
+				RX_RecordFunc(); //execute the user's function as a complete record is ready
+			}
+		}
+		else //the application still holds the other half , the new record is dropped and the same half is filled again
+		{
+			RX_RecordOverrun=TRUE;
+			RX_Stats.FramesDropped+=UART_RECORD_LENGTH;
+			RX_RecordErrors[RX_FillingHalf]=0;
+		}
+	}
+	return;
+  #endif
+
+  if(!PushFrame)
+  {
+	  //nothing to be stored
+  }
+  else if(!SPSC_IsTheBufferFull(&UART_RX_Buffer))
+  {
+  #if UART_PACKET_QUEUE == ENABLE
+	RX_OpenPacket.Length++;
+  #endif
+  #if FRAME_SIZE != _9_BITS_FRAME //in case of a NON 9bits frame only the frames with errors will be recorded in the RX_ErrorLog
+	if(FrameErrorLog)
+	{
+		if((u8)(RX_ErrorLogHead - RX_ErrorLogTail) < UART_RX_ERROR_LOG_SIZE)
+		{
+			//record the error before the frame is pushed so it's available once the frame is popped
+			RX_ErrorLog[RX_ErrorLogHead & RX_ERROR_LOG_MASK].FrameIndex=RX_PushedFrameIndex;
+			RX_ErrorLog[RX_ErrorLogHead & RX_ERROR_LOG_MASK].ErrorValue=FrameErrorLog;
+			RX_ErrorLogHead++;
+		}
+		else
+		{
+			RX_Stats.LostErrorLogs++; //no room in the log , the error is only counted
+		}
+	}
+  #endif
+	RX_PushedFrameIndex++;
+   SPSC_PushData(&UART_RX_Buffer, RX_Data); //store the data in the UART_RX_Buffer
+   FillLevel=SPSC_Count(&UART_RX_Buffer);
+   if(FillLevel > RX_Stats.HighWaterMark)
+   {
+	   RX_Stats.HighWaterMark=FillLevel;
+   }
+  #if UART_FLOW_CONTROL == ENABLE
+   if(FillLevel >= UART_RTS_HIGH_WATERMARK && RX_RTS_Deasserted==FALSE)
+   {
+	   SetPinValue(UART_RTS_PORT, UART_RTS_PIN, !UART_FLOW_ACTIVE_LEVEL); //ask the remote node to stop sending
+	   RX_RTS_Deasserted=TRUE;
+   }
+  #endif
+   if(RX_ReceiveFunc!=NULL && FillLevel >= RX_ReceiveThreshold)
+   {
+	   RX_ReceiveFunc(); //execute the user's function as the required number of frames is buffered
+   }
   }
   else
   {
 	  //the user has to read the data from the UART_RX_Buffer frequently to avoid filling the UART_RX_Buffer to it's full capacity
+	  RX_Stats.FramesDropped++;
+    #if UART_PACKET_QUEUE == ENABLE
+	  RX_OpenPacket.Status|=PACKET_FRAMES_DROPPED;
+    #endif
+  }
+
+  #if UART_LINE_FRAMING == ENABLE
+  if((RX_Data & 0x01FF) == UART_LINE_DELIMITER) //the line is closed even if the delimiter itself has been dropped
+  {
+	  UART_ClosePacket();
   }
+  #endif
+
+}
+#endif
+
+
+#if NODE_RECEIVE_DATA==ENABLE && FRAME_SIZE != _9_BITS_FRAME
+/**
+ * RETURN      : u8 variable that will contain the error value of the frame that has just been popped from the UART_RX_Buffer
+ * PARAMETERS  : void
+ * DESCRIPTION : static function that is used to check if the popped frame has been recorded in the RX_ErrorLog ,
+ *               if so the log entry is removed and it's error value is returned otherwise ZERO is returned
+ */
+static u8 UART_PopFrameErrorValue(void)
+{
+	u8 ErrorValue=0;
+	u8 Tail=RX_ErrorLogTail;
+	if(Tail != RX_ErrorLogHead && RX_ErrorLog[Tail & RX_ERROR_LOG_MASK].FrameIndex == RX_PoppedFrameIndex)
+	{
+		ErrorValue=RX_ErrorLog[Tail & RX_ERROR_LOG_MASK].ErrorValue;
+		RX_ErrorLogTail=Tail+1;
+	}
+	return ErrorValue;
+}
+#endif
+
+
+#if NODE_RECEIVE_DATA==ENABLE && UART_PACKET_QUEUE == ENABLE
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : static function that is used to close the packet "or line" that is being received and push it's descriptor to the RX_PacketQueue
+ *               it's executed from the idle timer ISR or the RX-ISR only
+ */
+static void UART_ClosePacket(void)
+{
+	u8 Head=RX_PacketQueueHead;
+	if((u8)(Head - RX_PacketQueueTail) < UART_PACKET_QUEUE_SIZE) //if the queue is full the packet will be discarded by the next UART_GetPacket() call
+	{
+		RX_PacketQueue[Head & PACKET_QUEUE_MASK].StartIndex=RX_OpenPacket.StartIndex;
+		RX_PacketQueue[Head & PACKET_QUEUE_MASK].Length    =RX_OpenPacket.Length;
+		RX_PacketQueue[Head & PACKET_QUEUE_MASK].Status    =RX_OpenPacket.Status;
+	  #if UART_RUNNING_CRC == ENABLE
+		RX_PacketQueue[Head & PACKET_QUEUE_MASK].CRC       =RX_CRC_Register^UART_CRC_FINAL_XOR;
+	  #endif
+		RX_PacketQueueHead=Head+1;
+		RX_PacketOpen=FALSE;
+		if(RX_PacketFunc!=NULL)
+		{
+			RX_PacketFunc(); //execute the user's function as a complete packet is queued
+		}
+	}
+	else
+	{
+		RX_PacketOpen=FALSE;
+	}
+}
+#endif
+
+
+#if NODE_RECEIVE_DATA==ENABLE && UART_IDLE_LINE_FRAMING == ENABLE
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : static function that is mounted on the idle timer compare match interrupt "executed every half character time"
+ *               once the idle gap reaches UART_IDLE_GAP_HALF_CHARS the packet that is being received is closed and it's descriptor is pushed to the RX_PacketQueue
+ */
+static void UART_IdleTimerTick(void)
+{
+	if(RX_PacketOpen)
+	{
+		RX_IdleHalfChars++;
+		if(RX_IdleHalfChars >= UART_IDLE_GAP_HALF_CHARS)
+		{
+			UART_ClosePacket();
+          #if UART_MULTIPROCESSOR_MODE == ENABLE
+			UART_SetMPCM(); //the packet has ended , return to the address listening mode
+          #endif
+		}
+	}
+}
+#endif
+
+
+#if NODE_TRANSMIT_DATA==ENABLE
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : static function that is used to start the TX-ISR once there is something to be sent
+ *               in case of the RS-485 driver enable control the DE pin is asserted before the first frame is loaded to UDR
+ *               the global interrupt is enabled by UART_init() , the frames are sent once it's enabled if the user has disabled it
+ */
+static void UART_TX_Start(void)
+{
+  #if UART_RS485_DE_CONTROL == ENABLE
+	ClearRegisterBit(UCSRB, TXCIE); //the bus mustn't be released by the previous transmission TX complete interrupt
+	SetPinValue(UART_DE_PORT, UART_DE_PIN, UART_DE_ACTIVE_LEVEL);
+  #else
+	TX_Started=TRUE;
+  #endif
+	//the global interrupt is left as it is , setting it here would allow nested interrupts when a frame is sent from an ISR callback
+	//"ex. the Modbus RTU response sent from the idle timer ISR"
+	SetRegisterBit(UCSRB ,UDRIE); //USART Data Register Empty Interrupt Enable
+}
+
 
+/**
+ * RETURN      : u8 variable that will be TRUE if the transmitter is idle "nothing left to be sent" or FALSE otherwise
+ * PARAMETERS  : void
+ * DESCRIPTION : static function that is used by UART_Flush() to check if the last frame has left the shift register
+ *               the TX-ISR disables it's interrupt only when there is nothing left to be sent , then the TXC flag "or the TX complete
+ *               ISR in case of the RS-485 driver enable control" tells that the last frame has been shifted out
+ */
+static u8 UART_TX_IsDrained(void)
+{
+	if(GetRegisterBit(UCSRB, UDRIE) || !SPSC_IsTheBufferEmpty(&UART_TX_Buffer))
+	{
+		return FALSE;
+	}
+  #if UART_BLOCK_TRANSMIT == ENABLE
+	if(TX_BlockActive)
+	{
+		return FALSE;
+	}
+  #endif
+  #if UART_RS485_DE_CONTROL == ENABLE
+	return !GetRegisterBit(UCSRB, TXCIE); //the TX complete ISR disables it's interrupt once the bus is released
+  #else
+	return (TX_Started==FALSE) || GetRegisterBit(UCSRA, TXC);
+  #endif
+}
+#endif
+
+
+/**
+ * RETURN      : u16 variable that will contain the UBRR value "rounded to the nearest value"
+ * PARAMETERS  : Divisor is the clock divisor of the operation mode "16 normal speed , 8 double speed , 2 synchronous master"
+ *               BaudRate is the required baud rate
+ *               BaudError is a pointer to u16 variable where the baud rate error in units of 0.1% will be stored
+ *               "0xFFFF in case the baud rate can't be achieved"
+ * DESCRIPTION : static function that is used by UART_SetBaud() to calculate the UBRR value at run time "same as the compile time solver"
+ */
+static u16 UART_CalcUBRR(u8 Divisor, u32 BaudRate, u16 *BaudError)
+{
+	u32 Denominator=((u32)Divisor)*BaudRate;
+	u32 UBRR_Value;
+	u32 ActualBaud;
+	u32 Difference;
+
+	UBRR_Value=(CPU_FREQ+(Denominator/2))/Denominator;
+	if((UBRR_Value == 0) || (UBRR_Value > 4096)) //UBRR register is 12bits wide
+	{
+		*BaudError=0xFFFF;
+		UBRR_Value=1;
+	}
+	else
+	{
+		ActualBaud=CPU_FREQ/(((u32)Divisor)*UBRR_Value);
+		Difference=UART_ABS_DIFF(ActualBaud, BaudRate);
+		if(Difference >= BaudRate)
+		{
+			*BaudError=0xFFFF;
+		}
+		else
+		{
+			*BaudError=(u16)((Difference*1000)/BaudRate);
+		}
+	}
+	return (u16)(UBRR_Value-1);
+}
+
+
+#if NODE_RECEIVE_DATA==ENABLE && UART_FLOW_CONTROL == ENABLE
+/**
+ * RETURN      : void
+ * PARAMETERS  : void
+ * DESCRIPTION : static function that is called after each read from the UART_RX_Buffer to assert the RTS pin again
+ *               once the number of unread frames drops to UART_RTS_LOW_WATERMARK
+ */
+static void UART_RTS_CheckLowWatermark(void)
+{
+	u8 SREG_Copy;
+	if(RX_RTS_Deasserted && SPSC_Count(&UART_RX_Buffer) <= UART_RTS_LOW_WATERMARK)
+	{
+		SREG_Copy=SREG; //save the global interrupt state
+		ClearRegisterBit(SREG, 7); //the RX-ISR mustn't deassert the RTS pin between the flag and the pin updates
+		RX_RTS_Deasserted=FALSE;
+		SetPinValue(UART_RTS_PORT, UART_RTS_PIN, UART_FLOW_ACTIVE_LEVEL);
+		SREG=SREG_Copy; //restore the global interrupt state
+	}
+}
+#endif
+
+
+#if NODE_TRANSMIT_DATA==ENABLE && UART_PRINTF == ENABLE
+/**
+ * RETURN      : u8 variable that will contain SUCCESSFUL_OPERATION or ERROR_BUFFER_FULL if the UART_TX_Buffer got full
+ * PARAMETERS  : Value is the absolute value to be printed and Negative is TRUE if a minus sign is required
+ *               Base is 10 or 16 , UpperCase selects the case of the hex digits
+ *               Width is the minimum field width and ZeroPad is TRUE if the field is padded with zeros instead of spaces
+ *               FracDigits is the number of digits after the decimal point "ZERO for integers"
+ *               Written is a pointer to the counter of the pushed characters
+ * DESCRIPTION : static function that is used by UART_Printf() to push a number to the UART_TX_Buffer
+ *               the digits are generated in reverse order into a small local array "up to 10 digits + decimal point for u32 values"
+ */
+static u8 UART_PrintNumber(u32 Value, u8 Negative, u8 Base, u8 UpperCase, u8 Width, u8 ZeroPad, u8 FracDigits, u16 *Written)
+{
+	c8  Digits[12];
+	u8  DigitsCount=0;
+	u8  FieldLength;
+	u8  Digit;
+	u8  Status=SUCCESSFUL_OPERATION;
+
+	if(FracDigits > 9)
+	{
+		FracDigits=9; //a u32 value has 10 digits at most
+	}
+	do
+	{
+		Digit=(u8)(Value % Base);
+		Value/=Base;
+		Digits[DigitsCount++]=(Digit < 10)?('0'+Digit):(((UpperCase)?'A':'a')+Digit-10);
+		if(DigitsCount == FracDigits)
+		{
+			Digits[DigitsCount++]='.';
+		}
+	}
+	while(Value != 0 || DigitsCount <= FracDigits+(FracDigits != 0)); //at least one digit before the decimal point
+
+	FieldLength=DigitsCount+(Negative != FALSE);
+	if(Negative && ZeroPad) //the minus sign comes before the padding zeros
+	{
+		Status=SPSC_PushData(&UART_TX_Buffer, '-');
+		*Written+=(Status == SUCCESSFUL_OPERATION);
+		Negative=FALSE;
+	}
+	while(FieldLength < Width && Status == SUCCESSFUL_OPERATION)
+	{
+		Status=SPSC_PushData(&UART_TX_Buffer, (ZeroPad)?'0':' ');
+		*Written+=(Status == SUCCESSFUL_OPERATION);
+		FieldLength++;
+	}
+	if(Negative && Status == SUCCESSFUL_OPERATION)
+	{
+		Status=SPSC_PushData(&UART_TX_Buffer, '-');
+		*Written+=(Status == SUCCESSFUL_OPERATION);
+	}
+	while(DigitsCount > 0 && Status == SUCCESSFUL_OPERATION)
+	{
+		DigitsCount--;
+		Status=SPSC_PushData(&UART_TX_Buffer, (u8)Digits[DigitsCount]);
+		*Written+=(Status == SUCCESSFUL_OPERATION);
+	}
+	return Status;
+}
+#endif
+
+
+#if UART_RUNNING_CRC == ENABLE
+/**
+ * RETURN      : UART_CRC_t variable that will contain the updated CRC register "before the final XOR"
+ * PARAMETERS  : CRC is the current CRC register value and Data is the next byte
+ * DESCRIPTION : static function that is used to update the CRC register with a single byte , the byte is processed one nibble at a time
+ *               using the 16 entries UART_CRC_Table , it's used by the RX-ISR , the TX-ISR and UART_CRC_Calc()
+ */
+static UART_CRC_t UART_CRC_Update(UART_CRC_t CRC, u8 Data)
+{
+#if UART_CRC_TYPE == UART_CRC16_CCITT //non reflected algorithm , the high nibble is processed first
+	CRC=(CRC<<4)^UART_CRC_Table[((CRC>>12)^(Data>>4)) & 0x0F];
+	CRC=(CRC<<4)^UART_CRC_Table[((CRC>>12)^Data) & 0x0F];
+#else //reflected algorithms , the low nibble is processed first
+	CRC^=Data;
+	CRC=(CRC>>4)^UART_CRC_Table[CRC & 0x0F];
+	CRC=(CRC>>4)^UART_CRC_Table[CRC & 0x0F];
+#endif
+	return CRC;
 }
 #endif
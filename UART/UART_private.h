@@ -46,6 +46,26 @@
 #define TXB8   ((u8)0)
 
 
+//UART_SendBlock() will return the following MACROS if a previous block is still being transmitted or the TX_Buffer isn't empty yet
+#define UART_TX_BUSY  ((u8)0x18)
+
+//UART_Flush() counts it's timeout in polls of the transmitter state instead of using <util/delay.h> "which depends on F_CPU not CPU_FREQ"
+//UART_FLUSH_POLL_CYCLES is a lower bound of the CPU cycles of one poll so the actual waiting time is never shorter than the timeout
+#define UART_FLUSH_POLL_CYCLES   16UL
+#define UART_FLUSH_POLLS_PER_MS  ((u32)((CPU_FREQ)/(1000UL*UART_FLUSH_POLL_CYCLES)))
+
+//COBS framing , the frame delimiter and the maximum number of data bytes that follow a single code byte
+#define COBS_DELIMITER        ((u8)0x00)
+#define COBS_MAX_BLOCK        ((u8)254)
+
+//UART_ReadLine() will return the following MACROS if the line was longer than the user's array "the rest of the line is discarded"
+#define UART_LINE_TRUNCATED  ((u8)0x19)
+
+//this macro should be used as return value if the function execution failed
+#ifndef FAILED_OPERATION
+#define FAILED_OPERATION   ((u8)0x00)
+#endif
+
 
 /*
   UARTData_t MACRO will define the data type of the data to be sent and received  "depending on the frame size"
@@ -58,4 +78,248 @@
 #define UARTData_t   u8
 #endif
 
+
+//the UART buffers are SPSC_Buffers with free running 8bit indices so their sizes must be powers of two
+#if (UART_TX_BUFFER_SIZE < 2) || (UART_TX_BUFFER_SIZE > 128) || ((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE-1)) != 0) || \
+    (UART_RX_BUFFER_SIZE < 2) || (UART_RX_BUFFER_SIZE > 128) || ((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE-1)) != 0)
+#error "UART_TX_BUFFER_SIZE and UART_RX_BUFFER_SIZE MUST be power of two values between 2 and 128"
+#endif
+
+//the RX error log uses free running 8bit indices so it's size must be a power of two
+#if (UART_RX_ERROR_LOG_SIZE < 2) || (UART_RX_ERROR_LOG_SIZE > 128) || ((UART_RX_ERROR_LOG_SIZE & (UART_RX_ERROR_LOG_SIZE-1)) != 0)
+#error "UART_RX_ERROR_LOG_SIZE MUST be a power of two value between 2 and 128"
+#endif
+
+#define RX_ERROR_LOG_MASK   ((u8)(UART_RX_ERROR_LOG_SIZE-1))
+
+//the error values stored in the RX error log and returned by UART_ReceiveDataFrame()
+#define RX_PARITY_ERROR     ((u8)0x01)
+#define RX_OVERRUN_ERROR    ((u8)0x02)
+#define RX_FRAME_ERROR      ((u8)0x04)
+
+
+/*
+  Compile time baud rate solver
+  the UBRR value of each mode is rounded to the nearest integer , then the actual baud rate and it's error in units of 0.1% are calculated
+  UART_RESOLVED_OPERATION_MODE will have the user's operation mode after resolving the AUTO_SPEED_ASYNCHRONOUS_UART mode
+  UART_UBRR_VALUE will have the value to be loaded to the UBRR registers
+*/
+#define UART_ABS_DIFF(A,B)         (((A)>(B))?((A)-(B)):((B)-(A)))
+#define UART_UBRR_CALC(Divisor)    (((CPU_FREQ)+((Divisor)*(BAUD_RATE)/2))/((Divisor)*(BAUD_RATE))-1)
+#define UART_BAUD_CALC(Divisor,UBRR)  ((CPU_FREQ)/((Divisor)*((UBRR)+1)))
+#define UART_BAUD_ERROR_CALC(Divisor,UBRR)  (UART_ABS_DIFF(UART_BAUD_CALC(Divisor,UBRR),(BAUD_RATE))*1000/(BAUD_RATE))
+
+#define UART_UBRR_NORMAL   UART_UBRR_CALC(16)
+#define UART_UBRR_DOUBLE   UART_UBRR_CALC(8)
+#define UART_UBRR_SYNC     UART_UBRR_CALC(2)
+#define UART_ERROR_NORMAL  UART_BAUD_ERROR_CALC(16,UART_UBRR_NORMAL)
+#define UART_ERROR_DOUBLE  UART_BAUD_ERROR_CALC(8,UART_UBRR_DOUBLE)
+#define UART_ERROR_SYNC    UART_BAUD_ERROR_CALC(2,UART_UBRR_SYNC)
+
+#if UART_OPERATION_MODE == AUTO_SPEED_ASYNCHRONOUS_UART
+  //the normal speed mode is preferred in case of equal errors as it has a better receiver noise tolerance
+  #if (UART_UBRR_NORMAL <= 4095) && (UART_ERROR_NORMAL <= UART_ERROR_DOUBLE)
+  #define UART_RESOLVED_OPERATION_MODE  NORMAL_ASYNCHRONOUS_UART
+  #else
+  #define UART_RESOLVED_OPERATION_MODE  DOUBLE_SPEED_ASYNCHRONOUS_UART
+  #endif
+#else
+#define UART_RESOLVED_OPERATION_MODE  UART_OPERATION_MODE
+#endif
+
+#if   UART_RESOLVED_OPERATION_MODE == NORMAL_ASYNCHRONOUS_UART
+#define UART_UBRR_VALUE         UART_UBRR_NORMAL
+#define UART_BAUD_ERROR         UART_ERROR_NORMAL
+#elif UART_RESOLVED_OPERATION_MODE == DOUBLE_SPEED_ASYNCHRONOUS_UART
+#define UART_UBRR_VALUE         UART_UBRR_DOUBLE
+#define UART_BAUD_ERROR         UART_ERROR_DOUBLE
+#else
+#define UART_UBRR_VALUE         UART_UBRR_SYNC
+#define UART_BAUD_ERROR         UART_ERROR_SYNC
+#endif
+
+#if UART_UBRR_VALUE > 4095
+#error "BAUD_RATE can't be achieved with the selected CPU_FREQ and UART operation mode "UBRR value out of range""
+#endif
+
+#if (UART_RESOLVED_OPERATION_MODE != SLAVE_SYNCHRONOUS_UART) && (UART_BAUD_ERROR > UART_MAX_BAUD_ERROR_PERMILLE)
+#error "The baud rate error exceeds UART_MAX_BAUD_ERROR_PERMILLE , change the BAUD_RATE or CPU_FREQ or use AUTO_SPEED_ASYNCHRONOUS_UART mode"
+#endif
+
+
+//number of bits in a single frame including the start , parity and stop bits
+#define UART_FRAME_DATA_BITS    (FRAME_SIZE+5)
+#if PARITY_MODE == NO_PARITY_CHK
+#define UART_FRAME_PARITY_BITS  0
+#else
+#define UART_FRAME_PARITY_BITS  1
+#endif
+#define UART_FRAME_STOP_BITS    (STOP_BITS_MODE+1)
+#define UART_FRAME_BITS         (1+UART_FRAME_DATA_BITS+UART_FRAME_PARITY_BITS+UART_FRAME_STOP_BITS)
+
+
+//multi-processor communication mode
+#define UART_ADDRESS_FRAME   ((u16)0x0100) //the 9th bit of the address frames , OR it with the node address to send an address frame
+#if UART_MULTIPROCESSOR_MODE == ENABLE
+  #if FRAME_SIZE != _9_BITS_FRAME
+  #error "UART_MULTIPROCESSOR_MODE requires FRAME_SIZE to be _9_BITS_FRAME"
+  #endif
+  #if (UART_NODE_ADDRESS > 0xFF) || (UART_BROADCAST_ADDRESS > 0xFF)
+  #error "UART_NODE_ADDRESS and UART_BROADCAST_ADDRESS MUST be 8bits values"
+  #endif
+#endif
+//writing ONE to the TXC flag clears it , so the MPCM bit is changed without writing back a pending TXC flag
+#define UART_SetMPCM()     (UCSRA = (UCSRA & ~(1<<TXC)) | (1<<MPCM))
+#define UART_ClearMPCM()   (UCSRA = UCSRA & ~((1<<TXC) | (1<<MPCM)))
+
+
+#if UART_FLOW_CONTROL == ENABLE
+  #if (UART_RTS_LOW_WATERMARK >= UART_RTS_HIGH_WATERMARK) || (UART_RTS_HIGH_WATERMARK > UART_RX_BUFFER_SIZE)
+  #error "UART_RTS_LOW_WATERMARK MUST be less than UART_RTS_HIGH_WATERMARK which MUST NOT exceed UART_RX_BUFFER_SIZE"
+  #endif
+#endif
+
+
+//running CRC , UART_CRC_t will be resolved to the CRC register size
+#if   UART_CRC_TYPE == UART_CRC32
+#define UART_CRC_t           u32
+#define UART_CRC_INIT        ((u32)0xFFFFFFFFUL)
+#define UART_CRC_FINAL_XOR   ((u32)0xFFFFFFFFUL)
+#elif (UART_CRC_TYPE == UART_CRC16_MODBUS) || (UART_CRC_TYPE == UART_CRC16_CCITT)
+#define UART_CRC_t           u16
+#define UART_CRC_INIT        ((u16)0xFFFF)
+#define UART_CRC_FINAL_XOR   ((u16)0x0000)
+#else
+#error "UART_CRC_TYPE MUST be UART_CRC16_MODBUS , UART_CRC16_CCITT or UART_CRC32"
+#endif
+
+
+//packet descriptor status flags
+#define PACKET_FRAMES_DROPPED   ((u8)0x01) //some frames of the packet have been dropped as the RX_Buffer was full
+#define PACKET_GAP_EXCEEDED     ((u8)0x02) //the gap between two frames of the packet exceeded UART_INTERCHAR_GAP_HALF_CHARS
+
+
+#if UART_IDLE_LINE_FRAMING == ENABLE || UART_AUTOBAUD == ENABLE
+#include "Timers_Interface.h"
+#endif
+
+
+#if UART_AUTOBAUD == ENABLE
+  #if (UART_OPERATION_MODE == MASTER_SYNCHRONOUS_UART) || (UART_OPERATION_MODE == SLAVE_SYNCHRONOUS_UART)
+  #error "UART_AUTOBAUD can only be used with the asynchronous UART operation modes"
+  #endif
+  #if TRIGGER_SOURCE != TRIGGER_SRC_ICP1
+  #error "UART_AUTOBAUD requires the Timer1 input capture TRIGGER_SOURCE to be TRIGGER_SRC_ICP1"
+  #endif
+  //get the prescaler division factor of Timer1 from TimersConfig.h to convert the measured ticks to a baud rate
+  #if   TIMER1_PRESCALER == T1_NO_PRESCALER
+  #define UART_AUTOBAUD_TIMER_DIV   1
+  #elif TIMER1_PRESCALER == T1_CLK_DIV_BY8
+  #define UART_AUTOBAUD_TIMER_DIV   8
+  #elif TIMER1_PRESCALER == T1_CLK_DIV_BY64
+  #define UART_AUTOBAUD_TIMER_DIV   64
+  #elif TIMER1_PRESCALER == T1_CLK_DIV_BY265
+  #define UART_AUTOBAUD_TIMER_DIV   256
+  #elif TIMER1_PRESCALER == T1_CLK_DIV_BY1024
+  #define UART_AUTOBAUD_TIMER_DIV   1024
+  #else
+  #error "Timer1 MUST be clocked from the CPU clock to be used by UART_AUTOBAUD"
+  #endif
+#endif
+
+
+//the packet queue is shared by the idle line packet framing , the delimiter line framing and the COBS framing modes
+#if (UART_IDLE_LINE_FRAMING == ENABLE) + (UART_LINE_FRAMING == ENABLE) + (UART_COBS_FRAMING == ENABLE) > 1
+#error "only one of UART_IDLE_LINE_FRAMING , UART_LINE_FRAMING and UART_COBS_FRAMING can be enabled"
+#endif
+#if UART_COBS_FRAMING == ENABLE && FRAME_SIZE != _8_BITS_FRAME
+#error "UART_COBS_FRAMING requires FRAME_SIZE to be _8_BITS_FRAME"
+#endif
+#if UART_IDLE_LINE_FRAMING == ENABLE || UART_LINE_FRAMING == ENABLE || UART_COBS_FRAMING == ENABLE
+#define UART_PACKET_QUEUE   ENABLE
+  #if (UART_PACKET_QUEUE_SIZE < 2) || (UART_PACKET_QUEUE_SIZE > 128) || ((UART_PACKET_QUEUE_SIZE & (UART_PACKET_QUEUE_SIZE-1)) != 0)
+  #error "UART_PACKET_QUEUE_SIZE MUST be a power of two value between 2 and 128"
+  #endif
+  #define PACKET_QUEUE_MASK   ((u8)(UART_PACKET_QUEUE_SIZE-1))
+#else
+#define UART_PACKET_QUEUE   DISABLE
+#endif
+
+//the ping-pong RX records replace the RX_Buffer so the modes that depend on it's content can't be used alongside it
+#if UART_PINGPONG_RX == ENABLE
+  #if UART_PACKET_QUEUE == ENABLE || UART_FLOW_CONTROL == ENABLE
+  #error "UART_PINGPONG_RX can't be used alongside the packet framing modes or the RTS/CTS flow control"
+  #endif
+  #if (UART_RECORD_LENGTH < 1) || (UART_RECORD_LENGTH > 255)
+  #error "UART_RECORD_LENGTH MUST be between 1 and 255"
+  #endif
+#endif
+
+
+#if UART_IDLE_LINE_FRAMING == ENABLE
+
+  //get the prescaler division factor of the idle timer from TimersConfig.h
+  #if UART_IDLE_TIMER == UART_IDLE_TIMER0
+    #if   TIMER0_PRESCALER == T0_NO_PRESCALER
+    #define UART_IDLE_TIMER_DIV   1
+    #elif TIMER0_PRESCALER == T0_CLK_DIV_BY8
+    #define UART_IDLE_TIMER_DIV   8
+    #elif TIMER0_PRESCALER == T0_CLK_DIV_BY64
+    #define UART_IDLE_TIMER_DIV   64
+    #elif TIMER0_PRESCALER == T0_CLK_DIV_BY265
+    #define UART_IDLE_TIMER_DIV   256
+    #elif TIMER0_PRESCALER == T0_CLK_DIV_BY1024
+    #define UART_IDLE_TIMER_DIV   1024
+    #else
+    #error "Timer0 MUST be clocked from the CPU clock to be used as the UART idle timer"
+    #endif
+    #define UART_IdleTimerCTCInit()       Timer0_CTCModeInit()
+    #define UART_IdleTimerSetComp(Value)  Timer0_SetCompValue(Value)
+    #define UART_IdleTimerMount(Func)     Timer0_ExecuteOnCompMatch(Func)
+    #define UART_IdleTimerEnable()        Timer0_Enable()
+    #define UART_IdleTimerRestart()       Timer0_CycleStartCountAt(0)
+
+  #elif UART_IDLE_TIMER == UART_IDLE_TIMER2
+    #ifdef ASYNCHRONOUS_CLK
+    #error "Timer2 MUST use the synchronous clock source to be used as the UART idle timer"
+    #endif
+    #if   TIMER2_PRESCALER == T2_NO_PRESCALER
+    #define UART_IDLE_TIMER_DIV   1
+    #elif TIMER2_PRESCALER == T2_CLK_DIV_BY8
+    #define UART_IDLE_TIMER_DIV   8
+    #elif TIMER2_PRESCALER == T2_CLK_DIV_BY32
+    #define UART_IDLE_TIMER_DIV   32
+    #elif TIMER2_PRESCALER == T2_CLK_DIV_BY64
+    #define UART_IDLE_TIMER_DIV   64
+    #elif TIMER2_PRESCALER == T2_CLK_DIV_BY128
+    #define UART_IDLE_TIMER_DIV   128
+    #elif TIMER2_PRESCALER == T2_CLK_DIV_BY256
+    #define UART_IDLE_TIMER_DIV   256
+    #elif TIMER2_PRESCALER == T2_CLK_DIV_BY1024
+    #define UART_IDLE_TIMER_DIV   1024
+    #endif
+    #define UART_IdleTimerCTCInit()       Timer2_CTCModeInit()
+    #define UART_IdleTimerSetComp(Value)  Timer2_SetCompValue(Value)
+    #define UART_IdleTimerMount(Func)     Timer2_ExecuteOnCompMatch(Func)
+    #define UART_IdleTimerEnable()        Timer2_Enable()
+    #define UART_IdleTimerRestart()       Timer2_CycleStartCountAt(0)
+  #endif
+
+  //the idle timer compare match will occur every half character time "rounded to the nearest timer tick"
+  #define UART_IDLE_TIMER_COMP_VALUE  (((CPU_FREQ*UART_FRAME_BITS)+(BAUD_RATE*UART_IDLE_TIMER_DIV))/(2*BAUD_RATE*UART_IDLE_TIMER_DIV)-1)
+  #if (UART_IDLE_TIMER_COMP_VALUE < 1) || (UART_IDLE_TIMER_COMP_VALUE > 255)
+  #error "Half a character time doesn't fit in the idle timer , change the idle timer prescaler in TimersConfig.h"
+  #endif
+#endif
+
+
+/*
+  RX_ErrorLogEntry_t is used to record a frame that has been received with errors
+  FrameIndex is the free running index of the frame in the RX_Buffer and ErrorValue is the frame's PE,DOR and FE values
+*/
+typedef struct {
+	u8 FrameIndex;
+	u8 ErrorValue;
+}RX_ErrorLogEntry_t;
+
 #endif /* UART_PRIVATE_H_ */